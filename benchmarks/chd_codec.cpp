@@ -0,0 +1,187 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+/*
+ * Hunk decompression speed of the CHD v5 codecs, as built by
+ * chd_codec_list for a CHD with the benchmarked hunk size.  The hunks
+ * are compressed by the matching chd_compressor, so the decompressors
+ * see exactly the streams chdman writes.  The source data is synthetic
+ * and shaped like a hard disk image: file system tables, text,
+ * code-like bytes and runs of zeroes.
+ *
+ * The argument is the hunk size: 4096 is the chdman default for hard
+ * disks, 19584 is eight CD frames with subcode.  The CD codecs (cdzl,
+ * cdlz, cdfl, cdzs) need whole frames, so they only run at 19584.
+ *
+ * The codecs need a chd_file to read the hunk size from, so each
+ * benchmark creates an empty uncompressed CHD in the working directory
+ * and deletes it again when done.
+ *
+ * Bytes/s in the output are decompressed bytes per second.  The zstd
+ * benchmarks are only built when USE_ZSTD is defined.
+ */
+
+#include "benchmark/benchmark_api.h"
+#include "chd.h"
+#include "cdrom.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const int HUNK_COUNT = 64;
+const char *const TEMP_CHD = "chd_codec_benchmark.chd";
+
+struct test_hunks
+{
+	unsigned hunkbytes;
+	std::vector<std::vector<uint8_t> > comp;
+	std::vector<uint8_t> dest;
+};
+
+/* deterministic pseudo random source */
+inline uint32_t next_random(uint32_t &state)
+{
+	state = state * 1664525 + 1013904223;
+	return state >> 8;
+}
+
+void build_image(std::vector<uint8_t> &image, unsigned size)
+{
+	static const char *const words[] = { "the ", "disk ", "file ", "error ", "DATA", "SYS ", "0000", "init ", "\r\n", "load " };
+	uint32_t rnd = 1;
+
+	image.assign(size, 0);
+	unsigned offs = 0;
+	while (offs < size)
+	{
+		const unsigned len = std::min(size - offs, 256 + next_random(rnd) % 2048);
+		switch (next_random(rnd) % 4)
+		{
+			case 0: /* allocation table */
+				for (unsigned i = 0; i + 1 < len; i += 2)
+				{
+					const unsigned value = (offs + i) / 2 + 1;
+					image[offs + i] = value & 0xff;
+					image[offs + i + 1] = value >> 8;
+				}
+				break;
+
+			case 1: /* text */
+				for (unsigned i = 0; i < len; )
+				{
+					const char *word = words[next_random(rnd) % 10];
+					for (unsigned j = 0; word[j] != 0 && i < len; j++)
+						image[offs + i++] = word[j];
+				}
+				break;
+
+			case 2: /* code, a skewed byte distribution */
+				for (unsigned i = 0; i < len; i++)
+				{
+					const uint32_t r = next_random(rnd);
+					image[offs + i] = (r & 3) ? (r >> 4) & 0x1f : r >> 4;
+				}
+				break;
+
+			case 3: /* unused sectors */
+				break;
+		}
+		offs += len;
+	}
+}
+
+/* compress every hunk with the codec; hunks it can't shrink are skipped like chdman stores them */
+void build_hunks(test_hunks &hunks, chd_file &chd, chd_codec_type type)
+{
+	const unsigned hunkbytes = chd.hunk_bytes();
+	std::vector<uint8_t> image;
+	build_image(image, hunkbytes * HUNK_COUNT);
+
+	std::unique_ptr<chd_compressor> compressor(chd_codec_list::new_compressor(type, chd));
+	if (compressor == nullptr)
+		abort();
+
+	hunks.hunkbytes = hunkbytes;
+	hunks.dest.resize(hunkbytes);
+	for (int hunknum = 0; hunknum < HUNK_COUNT; hunknum++)
+	{
+		std::vector<uint8_t> comp(hunkbytes);
+		try
+		{
+			const UINT32 complen = compressor->compress(&image[hunknum * hunkbytes], hunkbytes, &comp[0]);
+			if (complen < hunkbytes)
+			{
+				comp.resize(complen);
+				hunks.comp.push_back(comp);
+			}
+		}
+		catch (chd_error &)
+		{
+		}
+	}
+}
+
+/* decompress all the hunks round robin with the matching codec */
+void run_codec(benchmark::State& state, chd_codec_type type)
+{
+	const unsigned hunkbytes = state.range_x();
+	chd_codec_type compression[4] = { CHD_CODEC_NONE, CHD_CODEC_NONE, CHD_CODEC_NONE, CHD_CODEC_NONE };
+	chd_file chd;
+	if (chd.create(TEMP_CHD, UINT64(hunkbytes) * HUNK_COUNT, hunkbytes, (hunkbytes % CD_FRAME_SIZE == 0) ? CD_FRAME_SIZE : 512, compression) != CHDERR_NONE)
+		abort();
+
+	{
+		test_hunks hunks;
+		build_hunks(hunks, chd, type);
+		if (hunks.comp.empty())
+			abort();
+
+		std::unique_ptr<chd_decompressor> decompressor(chd_codec_list::new_decompressor(type, chd));
+		if (decompressor == nullptr)
+			abort();
+
+		size_t hunknum = 0;
+		while (state.KeepRunning()) {
+			const std::vector<uint8_t> &comp = hunks.comp[hunknum];
+			decompressor->decompress(&comp[0], comp.size(), &hunks.dest[0], hunks.hunkbytes);
+			benchmark::DoNotOptimize(hunks.dest[0]);
+			if (++hunknum == hunks.comp.size())
+				hunknum = 0;
+		}
+		state.SetBytesProcessed(int64_t(state.iterations()) * hunks.hunkbytes);
+	}
+
+	chd.close();
+	osd_rmfile(TEMP_CHD);
+}
+
+} // anonymous namespace
+
+static void BM_chd_zlib(benchmark::State& state) { run_codec(state, CHD_CODEC_ZLIB); }
+static void BM_chd_lzma(benchmark::State& state) { run_codec(state, CHD_CODEC_LZMA); }
+static void BM_chd_huff(benchmark::State& state) { run_codec(state, CHD_CODEC_HUFFMAN); }
+static void BM_chd_flac(benchmark::State& state) { run_codec(state, CHD_CODEC_FLAC); }
+static void BM_chd_cdzl(benchmark::State& state) { run_codec(state, CHD_CODEC_CD_ZLIB); }
+static void BM_chd_cdlz(benchmark::State& state) { run_codec(state, CHD_CODEC_CD_LZMA); }
+static void BM_chd_cdfl(benchmark::State& state) { run_codec(state, CHD_CODEC_CD_FLAC); }
+#ifdef USE_ZSTD
+static void BM_chd_zstd(benchmark::State& state) { run_codec(state, CHD_CODEC_ZSTD); }
+static void BM_chd_cdzs(benchmark::State& state) { run_codec(state, CHD_CODEC_CD_ZSTD); }
+#endif
+
+// Register the functions as benchmarks, (hunk size)
+BENCHMARK(BM_chd_zlib)->Arg(4096)->Arg(19584);
+BENCHMARK(BM_chd_lzma)->Arg(4096)->Arg(19584);
+BENCHMARK(BM_chd_huff)->Arg(4096)->Arg(19584);
+BENCHMARK(BM_chd_flac)->Arg(4096)->Arg(19584);
+BENCHMARK(BM_chd_cdzl)->Arg(19584);
+BENCHMARK(BM_chd_cdlz)->Arg(19584);
+BENCHMARK(BM_chd_cdfl)->Arg(19584);
+#ifdef USE_ZSTD
+BENCHMARK(BM_chd_zstd)->Arg(4096)->Arg(19584);
+BENCHMARK(BM_chd_cdzs)->Arg(19584);
+#endif
@@ -0,0 +1,192 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+/*
+ * Huffman decoding as done by the CHD huff codec and the AVHUFF video
+ * decoder: the tree is imported from its RLE form for every hunk, then
+ * a hunk worth of codes is decoded.
+ *
+ * The argument selects the data:
+ *
+ *   0 - bytes shaped like a hard disk image (text, tables, zeroes)
+ *   1 - small deltas shaped like laserdisc video rows
+ *
+ *   one      - huffman_decoder<>::decode_one, one code per lookup
+ *   multiple - huffman_decoder<>::decode_multiple, up to two codes per
+ *              lookup
+ *   pairs    - huffman_decoder<>::decode_pairs, even and odd bytes coded
+ *              with two trees and interleaved, both looked up from one
+ *              peek
+ *
+ * Bytes/s in the output are decoded bytes per second.
+ */
+
+#include "benchmark/benchmark_api.h"
+#include "huffman.h"
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const int HUNK_BYTES = 19584;
+
+/* deterministic pseudo random source */
+inline uint32_t next_random(uint32_t &state)
+{
+	state = state * 1664525 + 1013904223;
+	return state >> 8;
+}
+
+struct test_stream
+{
+	std::vector<UINT8> data;
+	std::vector<UINT8> tree;
+	std::vector<UINT8> codes;
+	std::vector<UINT8> pairtree[2];
+	std::vector<UINT8> paircodes;
+};
+
+/* export a tree in the RLE form the CHD codecs use */
+void export_tree(huffman_encoder<> &encoder, std::vector<UINT8> &tree)
+{
+	tree.resize(1024);
+	bitstream_out treebits(&tree[0], tree.size());
+	encoder.export_tree_rle(treebits);
+	tree.resize(treebits.flush());
+}
+
+void build_stream(test_stream &stream, int kind)
+{
+	static const char *const words[] = { "the ", "disk ", "file ", "error ", "DATA", "SYS ", "0000", "init ", "\r\n", "load " };
+	uint32_t rnd = 1;
+
+	stream.data.resize(HUNK_BYTES);
+	for (int i = 0; i < HUNK_BYTES; )
+	{
+		uint32_t r = next_random(rnd);
+		if (kind == 0)
+		{
+			/* runs of text, code-like bytes and zeroes */
+			int len = 64 + r % 512;
+			for (int j = 0; j < len && i < HUNK_BYTES; j++, i++)
+			{
+				const uint32_t v = next_random(rnd);
+				switch ((r >> 12) % 3)
+				{
+					case 0: stream.data[i] = words[(i / 5) % 10][i % 4]; break;
+					case 1: stream.data[i] = (v & 3) ? (v >> 4) & 0x1f : v >> 4; break;
+					case 2: stream.data[i] = 0; break;
+				}
+			}
+		}
+		else
+		{
+			/* mostly tiny deltas from the previous pixel */
+			int delta = 0;
+			while ((r & 3) != 0 && delta < 40)
+				delta++, r >>= 2, r |= next_random(rnd) << 20;
+			stream.data[i++] = (r & 4) ? delta : -delta;
+		}
+	}
+
+	/* build the tree and encode it separately from the codes */
+	huffman_encoder<> encoder;
+	for (int i = 0; i < HUNK_BYTES; i++)
+		encoder.histo_one(stream.data[i]);
+	encoder.compute_tree_from_histo();
+	export_tree(encoder, stream.tree);
+
+	stream.codes.resize(HUNK_BYTES * 3);
+	bitstream_out codebits(&stream.codes[0], stream.codes.size());
+	for (int i = 0; i < HUNK_BYTES; i++)
+		encoder.encode_one(codebits, stream.data[i]);
+	stream.codes.resize(codebits.flush());
+
+	/* the same data with a tree each for the even and odd bytes */
+	huffman_encoder<> pairencoder[2];
+	for (int i = 0; i < HUNK_BYTES; i++)
+		pairencoder[i & 1].histo_one(stream.data[i]);
+	for (int which = 0; which < 2; which++)
+	{
+		pairencoder[which].compute_tree_from_histo();
+		export_tree(pairencoder[which], stream.pairtree[which]);
+	}
+
+	stream.paircodes.resize(HUNK_BYTES * 3);
+	bitstream_out pairbits(&stream.paircodes[0], stream.paircodes.size());
+	for (int i = 0; i < HUNK_BYTES; i++)
+		pairencoder[i & 1].encode_one(pairbits, stream.data[i]);
+	stream.paircodes.resize(pairbits.flush());
+}
+
+void check(const test_stream &stream, const std::vector<UINT8> &dest)
+{
+	if (dest != stream.data)
+		abort();
+}
+
+} // anonymous namespace
+
+static void BM_huffman_one(benchmark::State& state) {
+	test_stream stream;
+	build_stream(stream, state.range_x());
+	std::vector<UINT8> dest(HUNK_BYTES);
+	huffman_decoder<> decoder;
+	while (state.KeepRunning()) {
+		bitstream_in treebits(&stream.tree[0], stream.tree.size());
+		decoder.import_tree_rle(treebits);
+		bitstream_in codebits(&stream.codes[0], stream.codes.size());
+		for (int i = 0; i < HUNK_BYTES; i++)
+			dest[i] = decoder.decode_one(codebits);
+		benchmark::DoNotOptimize(dest[0]);
+	}
+	check(stream, dest);
+	state.SetBytesProcessed(int64_t(state.iterations()) * HUNK_BYTES);
+}
+
+static void BM_huffman_multiple(benchmark::State& state) {
+	test_stream stream;
+	build_stream(stream, state.range_x());
+	std::vector<UINT8> dest(HUNK_BYTES);
+	huffman_decoder<> decoder;
+	while (state.KeepRunning()) {
+		bitstream_in treebits(&stream.tree[0], stream.tree.size());
+		decoder.import_tree_rle(treebits);
+		bitstream_in codebits(&stream.codes[0], stream.codes.size());
+		decoder.decode_multiple(codebits, &dest[0], HUNK_BYTES);
+		benchmark::DoNotOptimize(dest[0]);
+	}
+	check(stream, dest);
+	state.SetBytesProcessed(int64_t(state.iterations()) * HUNK_BYTES);
+}
+
+static void BM_huffman_pairs(benchmark::State& state) {
+	test_stream stream;
+	build_stream(stream, state.range_x());
+	std::vector<UINT16> pairs(HUNK_BYTES / 2);
+	huffman_decoder<> decoder[2];
+	while (state.KeepRunning()) {
+		for (int which = 0; which < 2; which++)
+		{
+			bitstream_in treebits(&stream.pairtree[which][0], stream.pairtree[which].size());
+			decoder[which].import_tree_rle(treebits);
+		}
+		bitstream_in codebits(&stream.paircodes[0], stream.paircodes.size());
+		decoder[0].decode_pairs(codebits, decoder[1], &pairs[0], HUNK_BYTES / 2);
+		benchmark::DoNotOptimize(pairs[0]);
+	}
+	std::vector<UINT8> dest(HUNK_BYTES);
+	for (int i = 0; i < HUNK_BYTES / 2; i++)
+	{
+		dest[i * 2] = pairs[i] >> 8;
+		dest[i * 2 + 1] = pairs[i];
+	}
+	check(stream, dest);
+	state.SetBytesProcessed(int64_t(state.iterations()) * HUNK_BYTES);
+}
+
+// Register the functions as benchmarks, (data kind)
+BENCHMARK(BM_huffman_one)->Arg(0)->Arg(1);
+BENCHMARK(BM_huffman_multiple)->Arg(0)->Arg(1);
+BENCHMARK(BM_huffman_pairs)->Arg(0)->Arg(1);
@@ -0,0 +1,91 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+/*
+ * Event queue used by netlist_t::process_queue, driven the way a TTL
+ * board drives it: every processed net schedules its fan-out after a
+ * gate delay of 10-30ns, and a small share of events is cancelled again
+ * (glitch suppression removes the net from the queue).
+ *
+ * The argument is the number of nets kept in flight.
+ *
+ * Items/s in the output are events per second.
+ */
+
+#include "benchmark/benchmark_api.h"
+#include "nl_lists.h"
+#include "nl_time.h"
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+typedef netlist::timed_queue<unsigned, netlist::netlist_time> queue_t;
+
+/* deterministic pseudo random gate delays and cancellations */
+inline uint32_t next_random(uint32_t &state)
+{
+	state = state * 1664525 + 1013904223;
+	return state >> 8;
+}
+
+void run_events(benchmark::State& state)
+{
+	const unsigned nets = state.range_x();
+	queue_t q(nets * 2);
+	uint32_t rnd = 1;
+	netlist::netlist_time now = netlist::netlist_time::zero;
+
+	/* each net is pending at most once, like a netlist net */
+	std::vector<char> pending(nets, 0);
+	for (unsigned i = 0; i < nets; i++)
+	{
+		q.push(queue_t::entry_t(netlist::netlist_time::from_nsec(next_random(rnd) % 30), i));
+		pending[i] = 1;
+	}
+
+	size_t events = 0;
+	while (state.KeepRunning()) {
+		for (int i = 0; i < 1000; i++)
+		{
+			const queue_t::entry_t &e = *q.pop();
+			const unsigned net = e.object();
+			now = e.exec_time();
+			pending[net] = 0;
+
+			/* fan-out of two, gate delay 10-30ns */
+			for (int k = 0; k < 2; k++)
+			{
+				const unsigned target = (net * 7 + k * 13 + 1) % nets;
+				if (!pending[target])
+				{
+					q.push(queue_t::entry_t(now + netlist::netlist_time::from_nsec(10 + next_random(rnd) % 21), target));
+					pending[target] = 1;
+				}
+				else if ((next_random(rnd) & 15) == 0)
+				{
+					/* input changed back before the output switched */
+					q.remove(target);
+					pending[target] = 0;
+				}
+			}
+			if (!q.is_not_empty())
+			{
+				q.push(queue_t::entry_t(now + netlist::netlist_time::from_nsec(1), 0));
+				pending[0] = 1;
+			}
+		}
+		events += 1000;
+	}
+	benchmark::DoNotOptimize(now.as_raw());
+	state.SetItemsProcessed(events);
+}
+
+} // anonymous namespace
+
+static void BM_netlist_queue(benchmark::State& state) {
+	run_events(state);
+}
+
+// Register the functions as benchmarks, (nets in flight)
+BENCHMARK(BM_netlist_queue)->Arg(8)->Arg(32)->Arg(128)->Arg(400);
@@ -0,0 +1,170 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+/*
+ * Linear equation kernels of the direct netlist matrix solver
+ * (matrix_solver_direct_t), run on synthetic nets shaped like the ones
+ * found in analog sound boards:
+ *
+ *   topology 0 - RC ladder (each net connects to its neighbours)
+ *   topology 1 - resistor mesh (neighbours in a square grid)
+ *
+ * Each net also has a conductance to a rail, so the matrix is
+ * diagonally dominant like the ones the solver builds.
+ */
+
+#include "benchmark/benchmark_api.h"
+#include "solver/nld_ms_direct.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using netlist::devices::solver_parameters_t;
+
+typedef netlist::devices::matrix_solver_direct_t<0, 128> direct_solver;
+
+/* gives the benchmarks access to the elimination kernels */
+class test_solver : public direct_solver
+{
+public:
+	test_solver(const solver_parameters_t *params, unsigned n, int topology)
+	: direct_solver(params, n), m_a(n * n, 0.0), m_x(n, 0.0)
+	{
+		build_net(topology);
+	}
+
+	/* load the matrix, as build_LE_A() would, then eliminate and back substitute */
+	void solve(unsigned step)
+	{
+		const unsigned n = N();
+		for (unsigned r = 0; r < n; r++)
+			for (unsigned c = 0; c < n; c++)
+				A(r, c) = m_a[r * n + c];
+		drive(step);
+		LE_solve();
+		LE_back_subst(m_x.data());
+	}
+
+	/* reuse the last elimination for a new right hand side */
+	void solve_cached(unsigned step)
+	{
+		drive(step);
+		LE_forward_subst();
+		LE_back_subst(m_x.data());
+	}
+
+	nl_double result() const { return m_x[0]; }
+
+private:
+	void connect(unsigned i, unsigned j, double g)
+	{
+		const unsigned n = N();
+		m_a[i * n + i] += g;
+		m_a[j * n + j] += g;
+		m_a[i * n + j] -= g;
+		m_a[j * n + i] -= g;
+	}
+
+	void build_net(int topology)
+	{
+		const unsigned n = N();
+		const unsigned width = std::max(1U, (unsigned) std::sqrt((double) n));
+
+		for (unsigned i = 0; i < n; i++)
+		{
+			/* capacitor to ground at 48kHz, plus gmin */
+			m_a[i * n + i] += 1e-8 * 48000.0 + 1e-9;
+			if (topology == 0)
+			{
+				if (i + 1 < n)
+					connect(i, i + 1, 1.0 / (1000.0 + 100.0 * i));
+			}
+			else
+			{
+				if ((i % width) + 1 < width && i + 1 < n)
+					connect(i, i + 1, 1.0 / 4700.0);
+				if (i + width < n)
+					connect(i, i + width, 1.0 / 10000.0);
+			}
+		}
+
+		/* fill-in pattern, as computed by vsetup() */
+		std::vector<char> touched(n * n);
+		for (unsigned i = 0; i < n * n; i++)
+			touched[i] = m_a[i] != 0.0;
+
+		for (unsigned k = 0; k < n; k++)
+			for (unsigned row = k + 1; row < n; row++)
+				if (touched[row * n + k])
+				{
+					m_terms[k]->m_nzbd.add(row);
+					m_lu_f.add(0.0);
+					for (unsigned col = k; col < n; col++)
+						if (touched[k * n + col])
+							touched[row * n + col] = 1;
+				}
+		for (unsigned k = 0; k < n; k++)
+			for (unsigned col = k + 1; col < n; col++)
+				if (touched[k * n + col])
+					m_terms[k]->m_nzrd.add(col);
+	}
+
+	/* an input signal which changes every time step */
+	void drive(unsigned step)
+	{
+		for (unsigned i = 0; i < N(); i++)
+			m_RHS[i] = 0.0;
+		m_RHS[0] = 5.0 * 1e-3 * (1.0 + std::sin(step * 0.01));
+	}
+
+	std::vector<nl_double> m_a;     /* row major, n * n */
+	std::vector<nl_double> m_x;
+};
+
+solver_parameters_t make_params(bool pivot)
+{
+	solver_parameters_t params = solver_parameters_t();
+	params.m_pivot = pivot;
+	params.m_accuracy = 1e-7;
+	params.m_max_timestep = 1.0 / 48000.0;
+	return params;
+}
+
+} // anonymous namespace
+
+static void BM_netlist_dense(benchmark::State& state) {
+	const solver_parameters_t params = make_params(true);
+	test_solver solver(&params, state.range_x(), state.range_y());
+	unsigned step = 0;
+	while (state.KeepRunning()) {
+		solver.solve(step++);
+		benchmark::DoNotOptimize(solver.result());
+	}
+}
+
+static void BM_netlist_sparse(benchmark::State& state) {
+	const solver_parameters_t params = make_params(false);
+	test_solver solver(&params, state.range_x(), state.range_y());
+	unsigned step = 0;
+	while (state.KeepRunning()) {
+		solver.solve(step++);
+		benchmark::DoNotOptimize(solver.result());
+	}
+}
+
+static void BM_netlist_cached(benchmark::State& state) {
+	const solver_parameters_t params = make_params(false);
+	test_solver solver(&params, state.range_x(), state.range_y());
+	unsigned step = 0;
+	solver.solve(step);
+	while (state.KeepRunning()) {
+		solver.solve_cached(step++);
+		benchmark::DoNotOptimize(solver.result());
+	}
+}
+
+// Register the functions as benchmarks, (size, topology)
+BENCHMARK(BM_netlist_dense)->ArgPair(8, 0)->ArgPair(31, 0)->ArgPair(49, 1)->ArgPair(87, 1);
+BENCHMARK(BM_netlist_sparse)->ArgPair(8, 0)->ArgPair(31, 0)->ArgPair(49, 1)->ArgPair(87, 1);
+BENCHMARK(BM_netlist_cached)->ArgPair(8, 0)->ArgPair(31, 0)->ArgPair(49, 1)->ArgPair(87, 1);
@@ -159,6 +159,11 @@ newoption {
     description = 'Build bundled PortAudio library',
 }
 
+newoption {
+    trigger = 'with-system-zstd',
+    description = 'Use system Zstandard library for the CHD zstd codecs',
+}
+
 newoption {
 	trigger = "distro",
 	description = "Choose distribution",
@@ -649,6 +654,12 @@ if not _OPTIONS["with-bundled-sqlite3"] then
 	}
 	end
 
+if _OPTIONS["with-system-zstd"] then
+	defines {
+		"USE_ZSTD",
+	}
+	end
+
 if _OPTIONS["NOASM"]=="1" then
 	defines {
 		"MAME_NOASM"
@@ -59,16 +59,60 @@ project("benchmarks")
 
 	links {
 		"benchmark",
+		"netlist",
+		"utils",
+		"7z",
+		"ocore_" .. _OPTIONS["osd"],
 	}
 
+if _OPTIONS["with-bundled-zlib"] then
+	links {
+		"zlib",
+	}
+else
+	links {
+		"z",
+	}
+end
+
+if _OPTIONS["with-bundled-flac"] then
+	links {
+		"flac",
+	}
+else
+	links {
+		"FLAC",
+	}
+end
+
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 	includedirs {
 		MAME_DIR .. "3rdparty/benchmark/include",
+		MAME_DIR .. "3rdparty",
 		MAME_DIR .. "src/osd",
+		MAME_DIR .. "src/lib",
+		MAME_DIR .. "src/lib/util",
+		MAME_DIR .. "src/lib/netlist",
+	}
+
+if _OPTIONS["with-bundled-zlib"] then
+	includedirs {
+		MAME_DIR .. "3rdparty/zlib",
 	}
+end
 
 	files {
 		MAME_DIR .. "benchmarks/main.cpp",
 		MAME_DIR .. "benchmarks/eminline_native.cpp",
 		MAME_DIR .. "benchmarks/eminline_noasm.cpp",
+		MAME_DIR .. "benchmarks/netlist_solver.cpp",
+		MAME_DIR .. "benchmarks/netlist_queue.cpp",
+		MAME_DIR .. "benchmarks/chd_codec.cpp",
+		MAME_DIR .. "benchmarks/huffman.cpp",
 	}
 
@@ -167,6 +167,12 @@ end
 		}
 	end
 
+	if _OPTIONS["with-system-zstd"] then
+		links {
+			"zstd",
+		}
+	end
+
 	if _OPTIONS["with-bundled-sqlite3"] then
 		links {
 			"sqllite3",
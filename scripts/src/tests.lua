@@ -78,8 +78,16 @@ project("tests")
 		MAME_DIR .. "src/lib/util",
 	}
 
+if _OPTIONS["with-bundled-zlib"] then
+	includedirs {
+		MAME_DIR .. "3rdparty/zlib",
+	}
+end
+
 	files {
 		MAME_DIR .. "tests/main.cpp",
 		MAME_DIR .. "tests/lib/util/corestr.cpp",
+		MAME_DIR .. "tests/lib/util/huffman.cpp",
+		MAME_DIR .. "tests/lib/util/png.cpp",
 	}
 
@@ -114,6 +114,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib/util",
@@ -238,6 +244,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/emu",
@@ -307,6 +319,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib/util",
@@ -374,6 +392,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib/util",
@@ -606,6 +630,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib/util",
@@ -728,6 +758,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib/util",
@@ -842,6 +878,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib",	
@@ -911,6 +953,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib",	
@@ -980,6 +1028,12 @@ else
 	}
 end
 
+if _OPTIONS["with-system-zstd"] then
+	links {
+		"zstd",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib",	
@@ -16,6 +16,8 @@
 #include "render.h"
 #include "chd.h"
 
+#include <algorithm>
+
 
 
 //**************************************************************************
@@ -72,6 +74,13 @@ laserdisc_device::laserdisc_device(const machine_config &mconfig, device_type ty
 		m_readresult(CHDERR_NONE),
 		m_chdtracks(0),
 		m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO)),
+		m_ahead_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI)),
+		m_ahead_current(nullptr),
+		m_ahead_active(false),
+		m_ahead_hits(0),
+		m_ahead_stalls(0),
+		m_ahead_misses(0),
+		m_ahead_wasted(0),
 		m_audiosquelch(0),
 		m_videosquelch(0),
 		m_fieldnum(0),
@@ -98,6 +107,7 @@ laserdisc_device::laserdisc_device(const machine_config &mconfig, device_type ty
 	m_orig_config.m_overposx = m_orig_config.m_overposy = 0.0f;
 	m_orig_config.m_overscalex = m_orig_config.m_overscaley = 1.0f;
 	*static_cast<laserdisc_overlay_config *>(this) = m_orig_config;
+	m_track_history[0] = m_track_history[1] = 0;
 }
 
 
@@ -107,6 +117,7 @@ laserdisc_device::laserdisc_device(const machine_config &mconfig, device_type ty
 
 laserdisc_device::~laserdisc_device()
 {
+	osd_work_queue_free(m_ahead_queue);
 	osd_work_queue_free(m_work_queue);
 }
 
@@ -334,6 +345,13 @@ void laserdisc_device::device_stop()
 	// make sure all async operations have completed
 	if (m_disc != nullptr)
 		osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 10);
+	for (auto & field : m_ahead)
+		wait_decoded(field);
+
+	// report how well decoding ahead kept up
+	if (m_ahead_hits + m_ahead_misses != 0)
+		osd_printf_verbose("Laserdisc %s: %d fields decoded ahead (%d stalled), %d not predicted, %d predicted but unused\n",
+			tag(), (int)m_ahead_hits, (int)m_ahead_stalls, (int)m_ahead_misses, (int)m_ahead_wasted);
 
 	// free any textures and palettes
 	if (m_videotex != nullptr)
@@ -361,6 +379,7 @@ void laserdisc_device::device_reset()
 	m_curtrack = 1;
 	m_attospertrack = 0;
 	m_sliderupdate = machine().time();
+	m_track_history[0] = m_track_history[1] = m_curtrack;
 }
 
 
@@ -818,6 +837,13 @@ void laserdisc_device::init_video()
 		frame.m_visbitmap.set_palette(m_videopalette);
 	}
 
+	// allocate the fields decoded ahead, and point their decoders at them
+	for (auto & field : m_ahead)
+	{
+		field.m_device = this;
+		field.m_bitmap.allocate(m_width, m_height);
+	}
+
 	// allocate an empty frame of the same size
 	m_emptyframe.allocate(m_width, m_height * 2);
 	m_emptyframe.set_palette(m_videopalette);
@@ -873,6 +899,21 @@ void laserdisc_device::init_audio()
 	m_audiobufsize = m_audiomaxsamples * 4;
 	m_audiobuffer[0].resize(m_audiobufsize);
 	m_audiobuffer[1].resize(m_audiobufsize);
+
+	// configure the decoders for decoding ahead; they always decode into their own buffers
+	for (auto & field : m_ahead)
+	{
+		avhuff_decompress_config config;
+		config.video.wrap(field.m_bitmap, field.m_bitmap.cliprect());
+		config.maxsamples = m_audiomaxsamples;
+		config.actsamples = &field.m_samples;
+		for (int chnum = 0; chnum < 2; chnum++)
+		{
+			field.m_audio[chnum].resize(m_audiomaxsamples);
+			config.audio[chnum] = &field.m_audio[chnum][0];
+		}
+		field.m_decoder.configure(config);
+	}
 }
 
 
@@ -986,10 +1027,7 @@ laserdisc_device::frame_data &laserdisc_device::current_frame()
 void laserdisc_device::read_track_data()
 {
 	// compute the chdhunk number we are going to read
-	INT32 chdtrack = m_curtrack - 1 - VIRTUAL_LEAD_IN_TRACKS;
-	chdtrack = MAX(chdtrack, 0);
-	chdtrack = MIN(chdtrack, m_chdtracks - 1);
-	UINT32 readhunk = chdtrack * 2 + m_fieldnum;
+	UINT32 readhunk = track_to_hunk(m_curtrack, m_fieldnum);
 
 	// cheat and look up the metadata we are about to retrieve
 	vbi_metadata vbidata = { 0 };
@@ -1057,8 +1095,9 @@ void laserdisc_device::read_track_data()
 		m_metadata[m_fieldnum].line17 = m_metadata[m_fieldnum].line18 = m_metadata[m_fieldnum].line1718 = VBI_CODE_LEADIN;
 	}
 
-	// configure the codec and then read
+	// configure the codec and then read, unless we decoded the field ahead
 	m_readresult = CHDERR_FILE_NOT_FOUND;
+	m_ahead_current = nullptr;
 	if (m_disc != nullptr && !m_videosquelch)
 	{
 		m_readresult = m_disc->codec_configure(CHD_CODEC_AVHUFF, AVHUFF_CODEC_DECOMPRESS_CONFIG, &m_avhuff_config);
@@ -1066,9 +1105,25 @@ void laserdisc_device::read_track_data()
 		{
 			m_queued_hunknum = readhunk;
 			m_readresult = CHDERR_OPERATION_PENDING;
-			osd_work_item_queue(m_work_queue, read_async_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+			m_ahead_current = find_decoded(readhunk);
+			if (m_ahead_current != nullptr)
+			{
+				m_ahead_hits++;
+				m_ahead_current->m_used = true;
+			}
+			else
+			{
+				if (m_ahead_active)
+					m_ahead_misses++;
+				osd_work_item_queue(m_work_queue, read_async_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+			}
+			decode_ahead(readhunk);
 		}
 	}
+
+	// remember where we have been, for predicting where we are going
+	m_track_history[1] = m_track_history[0];
+	m_track_history[0] = m_curtrack;
 }
 
 
@@ -1092,6 +1147,34 @@ void *laserdisc_device::read_async_static(void *param, int threadid)
 
 void laserdisc_device::process_track_data()
 {
+	// take the field from the decode ahead if we have it, waiting if it's still in progress
+	if (m_ahead_current != nullptr)
+	{
+		decoded_field &field = *m_ahead_current;
+		m_ahead_current = nullptr;
+		if (field.m_osd != nullptr && !osd_work_item_wait(field.m_osd, 0))
+			m_ahead_stalls++;
+		wait_decoded(field);
+
+		// copy it into the frame and the audio buffer
+		if (field.m_result == CHDERR_NONE)
+		{
+			bitmap_yuy16 &video = m_avhuff_config.video;
+			int width = MIN(video.width(), field.m_bitmap.width());
+			int height = MIN(video.height(), field.m_bitmap.height());
+			for (int y = 0; y < height; y++)
+				memcpy(&video.pix16(y), &field.m_bitmap.pix16(y), width * 2);
+			m_audiocursamples = field.m_samples;
+			for (int chnum = 0; chnum < 2; chnum++)
+				memcpy(m_avhuff_config.audio[chnum], &field.m_audio[chnum][0], field.m_samples * 2);
+			m_readresult = CHDERR_NONE;
+		}
+
+		// if that failed, read it the normal way; the codec is already configured
+		else
+			m_readresult = m_disc->read_hunk(m_queued_hunknum, nullptr);
+	}
+
 	// wait for the async operation to complete
 	if (m_readresult == CHDERR_OPERATION_PENDING)
 		osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 10);
@@ -1132,6 +1215,135 @@ void laserdisc_device::process_track_data()
 }
 
 
+//-------------------------------------------------
+//  track_to_hunk - return the CHD hunk holding
+//  the given field of a track
+//-------------------------------------------------
+
+UINT32 laserdisc_device::track_to_hunk(INT32 track, int fieldnum) const
+{
+	INT32 chdtrack = track - 1 - VIRTUAL_LEAD_IN_TRACKS;
+	chdtrack = MAX(chdtrack, 0);
+	chdtrack = MIN(chdtrack, m_chdtracks - 1);
+	return chdtrack * 2 + fieldnum;
+}
+
+
+//-------------------------------------------------
+//  find_decoded - find a field that has been
+//  decoded ahead, or is being decoded
+//-------------------------------------------------
+
+laserdisc_device::decoded_field *laserdisc_device::find_decoded(UINT32 hunknum)
+{
+	for (auto & field : m_ahead)
+		if (field.m_hunknum == hunknum)
+			return &field;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  decode_ahead - predict the fields following
+//  the one being read and start decoding them on
+//  other threads
+//-------------------------------------------------
+
+void laserdisc_device::decode_ahead(UINT32 readhunk)
+{
+	// the player moves the same distance every two fields whether it is playing, stepping,
+	// scanning or paused, so the tracks from the last two fields give the direction and speed;
+	// after a seek this is wrong for a couple of fields and then settles again
+	INT32 stride = m_curtrack - m_track_history[1];
+	UINT32 predicted[DECODE_AHEAD_FIELDS];
+	for (int ahead = 1; ahead <= DECODE_AHEAD_FIELDS; ahead++)
+	{
+		INT32 track = ((ahead & 1) ? m_track_history[0] : m_curtrack) + stride * ((ahead + 1) / 2);
+		track = MAX(track, 1);
+		track = MIN(track, m_maxtrack - 1);
+		predicted[ahead - 1] = track_to_hunk(track, m_fieldnum ^ (ahead & 1));
+	}
+
+	// queue up whatever isn't there yet, nearest first
+	for (auto hunknum : predicted)
+	{
+		if (find_decoded(hunknum) != nullptr)
+			continue;
+
+		// reuse an entry that isn't predicted, isn't in use and isn't still decoding
+		decoded_field *victim = nullptr;
+		for (auto & field : m_ahead)
+		{
+			if (&field == m_ahead_current || std::find(std::begin(predicted), std::end(predicted), field.m_hunknum) != std::end(predicted))
+				continue;
+			if (field.m_osd != nullptr)
+			{
+				if (!osd_work_item_wait(field.m_osd, 0))
+					continue;
+				wait_decoded(field);
+			}
+			victim = &field;
+			break;
+		}
+		if (victim == nullptr)
+			break;
+
+		// start decoding
+		if (victim->m_hunknum != ~0 && !victim->m_used)
+			m_ahead_wasted++;
+		victim->m_hunknum = hunknum;
+		victim->m_used = false;
+		victim->m_osd = osd_work_item_queue(m_ahead_queue, decode_async_static, victim, 0);
+		if (victim->m_osd == nullptr)
+		{
+			victim->m_hunknum = ~0;
+			break;
+		}
+		m_ahead_active = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  wait_decoded - wait for a field being decoded
+//  ahead to finish
+//-------------------------------------------------
+
+void laserdisc_device::wait_decoded(decoded_field &field)
+{
+	if (field.m_osd == nullptr)
+		return;
+	while (!osd_work_item_wait(field.m_osd, osd_ticks_per_second()))
+		;
+	osd_work_item_release(field.m_osd);
+	field.m_osd = nullptr;
+}
+
+
+//-------------------------------------------------
+//  decode_async_static - work item callback for
+//  decoding a field ahead
+//-------------------------------------------------
+
+void *laserdisc_device::decode_async_static(void *param, int threadid)
+{
+	decoded_field &field = *reinterpret_cast<decoded_field *>(param);
+
+	// read the compressed data; this doesn't disturb the chd_file's own codec
+	UINT32 complen;
+	chd_codec_type codec;
+	field.m_result = field.m_device->m_disc->read_compressed_hunk(field.m_hunknum, field.m_compressed, complen, codec);
+	if (field.m_result == CHDERR_NONE && codec != CHD_CODEC_AVHUFF)
+		field.m_result = CHDERR_UNSUPPORTED_FORMAT;
+
+	// decode it with this entry's own decoder
+	field.m_samples = 0;
+	if (field.m_result == CHDERR_NONE && field.m_decoder.decode_data(&field.m_compressed[0], complen, nullptr) != AVHERR_NONE)
+		field.m_result = CHDERR_DECOMPRESSION_ERROR;
+	return nullptr;
+}
+
+
 
 //**************************************************************************
 //  CONFIG SETTINGS ACCESS
@@ -272,6 +272,23 @@ private:
 		INT32               m_lastfield;            // last absolute field number
 	};
 
+	// a field decoded ahead of time on a worker thread
+	struct decoded_field
+	{
+		decoded_field() : m_device(nullptr), m_hunknum(~0), m_osd(nullptr), m_result(CHDERR_NONE), m_samples(0), m_used(false) { }
+
+		laserdisc_device *  m_device;               // pointer back to the device
+		UINT32              m_hunknum;              // hunk being decoded, or ~0 if none
+		osd_work_item *     m_osd;                  // decode in progress
+		chd_error           m_result;               // result of the decode
+		bitmap_yuy16        m_bitmap;               // decoded video for one field
+		std::vector<INT16>  m_audio[2];             // decoded audio samples
+		UINT32              m_samples;              // number of audio samples decoded
+		bool                m_used;                 // has the player reached this field?
+		dynamic_buffer      m_compressed;           // compressed data for the hunk
+		avhuff_decoder      m_decoder;              // decoder private to this entry
+	};
+
 	// internal helpers
 	void init_disc();
 	void init_video();
@@ -284,6 +301,11 @@ private:
 	void read_track_data();
 	static void *read_async_static(void *param, int threadid);
 	void process_track_data();
+	UINT32 track_to_hunk(INT32 track, int fieldnum) const;
+	decoded_field *find_decoded(UINT32 hunknum);
+	void decode_ahead(UINT32 readhunk);
+	void wait_decoded(decoded_field &field);
+	static void *decode_async_static(void *param, int threadid);
 	void config_load(config_type cfg_type, xml_data_node *parentnode);
 	void config_save(config_type cfg_type, xml_data_node *parentnode);
 
@@ -312,6 +334,18 @@ private:
 	osd_work_queue *    m_work_queue;           // work queue
 	UINT32              m_queued_hunknum;       // queued hunk
 
+	// decode ahead
+	static const int DECODE_AHEAD_FIELDS = 4;   // fields to decode ahead of the player
+	osd_work_queue *    m_ahead_queue;          // work queue for decoding ahead
+	decoded_field       m_ahead[DECODE_AHEAD_FIELDS + 2]; // fields decoded ahead, plus the one in use and a spare
+	decoded_field *     m_ahead_current;        // entry supplying the field being read, or nullptr
+	INT32               m_track_history[2];     // tracks read one and two fields ago
+	bool                m_ahead_active;         // have we predicted anything yet?
+	UINT64              m_ahead_hits;           // fields found already decoded or decoding
+	UINT64              m_ahead_stalls;         // hits where we had to wait for the decode
+	UINT64              m_ahead_misses;         // fields that weren't predicted
+	UINT64              m_ahead_wasted;         // predicted fields that were never used
+
 	// core states
 	UINT8               m_audiosquelch;         // audio squelch state: bit 0 = audio 1, bit 1 = audio 2
 	UINT8               m_videosquelch;         // video squelch state: bit 0 = on/off
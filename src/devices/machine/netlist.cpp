@@ -516,7 +516,9 @@ ATTR_COLD offs_t netlist_mame_cpu_device_t::disasm_disassemble(char *buffer, off
 	int relpc = pc - m_genPC;
 	if (relpc >= 0 && relpc < netlist().queue().count())
 	{
-		int dpc = netlist().queue().count() - relpc - 1;
+		/* sorted, the queue lists the next event first */
+		netlist().queue().sort();
+		int dpc = relpc;
 		// FIXME: 50 below fixes crash in mame-debugger. It's based on try on error.
 		snprintf(buffer, 50, "%c %s @%10.7f", (relpc == 0) ? '*' : ' ', netlist().queue()[dpc].object()->name().cstr(),
 				netlist().queue()[dpc].exec_time().as_double());
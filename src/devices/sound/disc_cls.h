@@ -60,6 +60,34 @@ private:                                                                \
 	_priv                                                               \
 }
 
+#define  DISCRETE_CLASS_STEP_RESET_BLOCK(_name, _maxout, _priv)         \
+class DISCRETE_CLASS_NAME(_name): public discrete_base_node, public discrete_step_interface, public discrete_block_step_interface \
+{                                                                       \
+	DISCRETE_CLASS_CONSTRUCTOR(_name, base)                             \
+	DISCRETE_CLASS_DESTRUCTOR(_name)                                    \
+public:                                                                 \
+	virtual void step(void) override;                                   \
+	virtual void step_block(const double * const *inputs, double *output, int samples) override; \
+	virtual void reset(void) override;                                  \
+	virtual int max_output(void) override { return _maxout; }           \
+private:                                                                \
+	_priv                                                               \
+}
+
+#define DISCRETE_CLASS_STEP_BLOCK(_name, _maxout, _priv)                \
+class DISCRETE_CLASS_NAME(_name): public discrete_base_node, public discrete_step_interface, public discrete_block_step_interface \
+{                                                                       \
+	DISCRETE_CLASS_CONSTRUCTOR(_name, base)                             \
+	DISCRETE_CLASS_DESTRUCTOR(_name)                                    \
+public:                                                                 \
+	virtual void step(void) override;                                   \
+	virtual void step_block(const double * const *inputs, double *output, int samples) override; \
+	virtual void reset(void) override  { this->step(); }                \
+	virtual int max_output(void) override { return _maxout; }           \
+private:                                                                \
+	_priv                                                               \
+}
+
 #define  DISCRETE_CLASS_RESET(_name, _maxout)                           \
 class DISCRETE_CLASS_NAME(_name): public discrete_base_node             \
 {                                                                       \
@@ -109,7 +137,8 @@ public:
 
 class DISCRETE_CLASS_NAME(dso_output):  public discrete_base_node,
 										public discrete_sound_output_interface,
-										public discrete_step_interface
+										public discrete_step_interface,
+										public discrete_block_step_interface
 {
 	DISCRETE_CLASS_CONSTRUCTOR(dso_output, base)
 	DISCRETE_CLASS_DESTRUCTOR(dso_output)
@@ -120,6 +149,12 @@ public:
 		double val = DISCRETE_INPUT(0) * DISCRETE_INPUT(1);
 		*m_ptr++ = val;
 	}
+	virtual void step_block(const double * const *inputs, double *output, int samples) override {
+		const double *in = inputs[0], *gain = inputs[1];
+		for (int i = 0; i < samples; i++)
+			m_ptr[i] = in[i] * gain[i];
+		m_ptr += samples;
+	}
 	virtual int max_output(void) override { return 0; }
 	virtual void set_output_ptr(stream_sample_t *ptr) override { m_ptr = ptr; }
 private:
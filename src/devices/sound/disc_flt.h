@@ -32,12 +32,12 @@ struct discrete_filter_coeff
 };
 
 
-DISCRETE_CLASS_STEP_RESET(dst_filter1, 1,
+DISCRETE_CLASS_STEP_RESET_BLOCK(dst_filter1, 1,
 	/* uses x1, y1, a1, b0, b1 */
 	struct discrete_filter_coeff m_fc;
 );
 
-DISCRETE_CLASS_STEP_RESET(dst_filter2, 1,
+DISCRETE_CLASS_STEP_RESET_BLOCK(dst_filter2, 1,
 	struct discrete_filter_coeff m_fc;
 );
 
@@ -143,7 +143,7 @@ DISCRETE_CLASS_STEP_RESET(dst_rcdisc_mod, 1,
 	double          m_vd_gain[4];
 );
 
-DISCRETE_CLASS_STEP_RESET(dst_rcfilter, 1,
+DISCRETE_CLASS_STEP_RESET_BLOCK(dst_rcfilter, 1,
 	double          m_v_out;
 	double          m_vCap;
 	double          m_rc;
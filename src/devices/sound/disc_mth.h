@@ -23,13 +23,13 @@
 
 #include "discrete.h"
 
-DISCRETE_CLASS_STEP(dst_adder, 1, /* no context */ );
+DISCRETE_CLASS_STEP_BLOCK(dst_adder, 1, /* no context */ );
 
 DISCRETE_CLASS_STEP(dst_clamp, 1, /* no context */ );
 
 DISCRETE_CLASS_STEP(dst_divide, 1, /* no context */ );
 
-DISCRETE_CLASS_STEP(dst_gain, 1, /* no context */ );
+DISCRETE_CLASS_STEP_BLOCK(dst_gain, 1, /* no context */ );
 
 DISCRETE_CLASS_STEP(dst_logic_inv, 1, /* no context */ );
 
@@ -168,7 +168,7 @@ DISCRETE_CLASS_STEP_RESET(dst_integrate, 1,
 );
 
 #define DISC_MIXER_MAX_INPS 8
-DISCRETE_CLASS_STEP_RESET(dst_mixer, 1,
+DISCRETE_CLASS_STEP_RESET_BLOCK(dst_mixer, 1,
 	int             m_type;
 	int             m_size;
 	int             m_r_node_bit_flag;
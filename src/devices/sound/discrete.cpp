@@ -39,6 +39,8 @@
 #include "sound/wavwrite.h"
 #include "discrete.h"
 
+#include <algorithm>
+
 /* for_each collides with c++ standard libraries - include it here */
 #define for_each(_T, _e, _l) for (_T _e = (_l)->begin_ptr() ;  _e <= (_l)->end_ptr(); _e++)
 
@@ -80,6 +82,27 @@ const device_type DISCRETE = &device_creator<discrete_sound_device>;
 
 #define USE_DISCRETE_TASKS          (1)
 
+/*
+ * With -discrete_auto_tasks, netlists without DISCRETE_TASK_START/END
+ * are split into independent branches which run in parallel, followed
+ * by a final task which combines them.  Branches smaller than
+ * DISCRETE_AUTO_MIN_TASK_NODES are not worth the buffering overhead
+ * and stay in the final task.
+ */
+
+#define DISCRETE_AUTO_MIN_TASK_NODES (4)
+#define DISCRETE_AUTO_MAX_TASKS     (4)
+#define DISCRETE_AUTO_MAX_PEEL      (4)
+
+/*
+ * Nodes at the end of a task which have no feedback and implement
+ * discrete_block_step_interface (mixers, filters, gains, outputs)
+ * are stepped a whole slice at a time instead of once per sample.
+ */
+
+#define USE_DISCRETE_BLOCK_STEPPING (1)
+#define DISCRETE_MIN_BLOCK_NODES    (2)
+
 /*************************************
  *
  *  Internal classes
@@ -92,6 +115,7 @@ struct output_buffer
 	const double                *source;
 	volatile double             *ptr;
 	int                         node_num;
+	const double                *block_output;      /* source is block stepped, copy per slice */
 };
 
 struct input_buffer
@@ -99,6 +123,11 @@ struct input_buffer
 	volatile const double       *ptr;               /* pointer into linked_outbuf.nodebuf */
 	output_buffer *             linked_outbuf;      /* what output are we connected to ? */
 	double                      buffer;             /* input[] will point here */
+
+	/* the lists grow while tasks are checked, so pointers are resolved afterwards */
+	discrete_task *             linked_task;        /* task holding the output buffer */
+	int                         linked_index;       /* index into its buffer list */
+	const double **             input;              /* input of the consuming node */
 };
 
 class discrete_task
@@ -108,6 +137,7 @@ public:
 	virtual ~discrete_task(void) { }
 
 	inline void step_nodes(void);
+	inline void step_block(int samples);
 	inline bool lock_threadid(INT32 threadid)
 	{
 		INT32 prev_id;
@@ -126,7 +156,7 @@ public:
 
 
 	discrete_task(discrete_device &pdev)
-	: task_group(0), m_device(pdev), m_threadid(-1), m_samples(0)
+	: task_group(0), m_device(pdev), m_run_time(0), m_slices(0), m_stalls(0), m_step_count(0), m_block_pos(0), m_threadid(-1), m_samples(0)
 {
 		source_list.clear();
 		step_list.clear();
@@ -138,11 +168,40 @@ protected:
 	inline bool process(void);
 
 	void check(discrete_task *dest_task);
+	void link_sources(void);
 	void prepare_for_queue(int samples);
+	void setup_block_stepping(void);
 
 	vector_t<output_buffer>      m_buffers;
 	discrete_device &                   m_device;
 
+	/* profiling */
+	osd_ticks_t             m_run_time;     /* ticks spent in process() */
+	UINT32                  m_slices;       /* number of slices processed */
+	UINT32                  m_stalls;       /* slices waiting on input */
+
+	/* block stepped nodes at the end of the step list */
+	struct block_node
+	{
+		discrete_block_step_interface * node;
+		discrete_step_interface *       step;
+		const double *                  inputs[DISCRETE_MAX_INPUTS];
+		double *                        output;
+	};
+
+	/* per sample copy of an input coming from outside the block */
+	struct block_capture
+	{
+		const double *          source;
+		double *                buffer;
+	};
+
+	int                         m_step_count;   /* nodes stepped sample by sample */
+	int                         m_block_pos;    /* sample within the current slice */
+	vector_t<block_node>        m_block_nodes;
+	vector_t<block_capture>     m_block_captures;
+	vector_t<double *>          m_block_constants;
+
 private:
 	volatile INT32          m_threadid;
 	volatile int            m_samples;
@@ -179,6 +238,9 @@ private:
 
 inline void discrete_task::step_nodes(void)
 {
+	discrete_step_interface **first = step_list.begin_ptr();
+	discrete_step_interface **last = first + m_step_count;
+
 	for_each(input_buffer *, sn, &source_list)
 	{
 		sn->buffer = *sn->ptr++;
@@ -186,7 +248,7 @@ inline void discrete_task::step_nodes(void)
 
 	if (EXPECTED(!m_device.profiling()))
 	{
-		for_each(discrete_step_interface **, entry, &step_list)
+		for (discrete_step_interface **entry = first; entry < last; entry++)
 		{
 			/* Now step the node */
 			(*entry)->step();
@@ -194,39 +256,85 @@ inline void discrete_task::step_nodes(void)
 	}
 	else
 	{
-		osd_ticks_t last = get_profile_ticks();
+		osd_ticks_t last_ticks = get_profile_ticks();
 
-		for_each(discrete_step_interface **, entry, &step_list)
+		for (discrete_step_interface **entry = first; entry < last; entry++)
 		{
 			discrete_step_interface *node = *entry;
 
-			node->run_time -= last;
+			node->run_time -= last_ticks;
 			node->step();
-			last = get_profile_ticks();
-			node->run_time += last;
+			last_ticks = get_profile_ticks();
+			node->run_time += last_ticks;
+		}
+	}
+
+	/* keep the inputs of the block stepped nodes */
+	for_each(block_capture *, cap, &m_block_captures)
+		cap->buffer[m_block_pos] = *cap->source;
+	m_block_pos++;
+
+	/* buffer the outputs */
+	for_each(output_buffer *, outbuf, &m_buffers)
+		if (outbuf->block_output == nullptr)
+			*(outbuf->ptr++) = *outbuf->source;
+}
+
+inline void discrete_task::step_block(int samples)
+{
+	for_each(block_node *, bn, &m_block_nodes)
+	{
+		if (EXPECTED(!m_device.profiling()))
+			bn->node->step_block(bn->inputs, bn->output, samples);
+		else
+		{
+			bn->step->run_time -= get_profile_ticks();
+			bn->node->step_block(bn->inputs, bn->output, samples);
+			bn->step->run_time += get_profile_ticks();
 		}
+		bn->step->self->m_output[0] = bn->output[samples - 1];
 	}
 
 	/* buffer the outputs */
 	for_each(output_buffer *, outbuf, &m_buffers)
-		*(outbuf->ptr++) = *outbuf->source;
+		if (outbuf->block_output != nullptr)
+		{
+			for (int i = 0; i < samples; i++)
+				outbuf->ptr[i] = outbuf->block_output[i];
+			outbuf->ptr += samples;
+		}
 }
 
 void *discrete_task::task_callback(void *param, int threadid)
 {
 	task_list_t *list = (task_list_t *) param;
+	int count = list->count();
+	/* all workers share the one task list; spread their starting points
+	 * so they do not all fight for the first task */
+	int start = (threadid < 0 ? 0 : threadid) % count;
 	do
 	{
-		for_each(discrete_task **, task, list)
+		bool progress = false;
+
+		for (int i = 0; i < count; i++)
 		{
+			discrete_task *task = (*list)[(start + i) % count];
+
 			/* try to lock */
-			if ((*task)->lock_threadid(threadid))
+			if (task->lock_threadid(threadid))
 			{
-				if (!(*task)->process())
+				int before = task->m_samples;
+				if (!task->process())
 					return nullptr;
-				(*task)->unlock();
+				if (task->m_samples != before)
+					progress = true;
+				task->unlock();
 			}
 		}
+
+		/* everything we could get at is waiting on input - let the producers run */
+		if (!progress)
+			osd_yield_processor();
 	} while (1);
 
 	return nullptr;
@@ -235,6 +343,7 @@ void *discrete_task::task_callback(void *param, int threadid)
 bool discrete_task::process(void)
 {
 	int samples = MIN(m_samples, MAX_SAMPLES_PER_TASK_SLICE);
+	osd_ticks_t start = 0;
 
 	/* check dependencies */
 	for_each(input_buffer *, sn, &source_list)
@@ -247,14 +356,29 @@ bool discrete_task::process(void)
 			samples = avail;
 	}
 
+	if (UNEXPECTED(m_device.profiling()))
+	{
+		if (samples == 0)
+			m_stalls++;
+		else
+			m_slices++;
+		start = get_profile_ticks();
+	}
+
 	m_samples -= samples;
 	assert_always(m_samples >=0, "task_callback: task_samples got negative");
-	while (samples > 0)
+	m_block_pos = 0;
+	for (int i = 0; i < samples; i++)
 	{
 		/* step */
 		step_nodes();
-		samples--;
 	}
+	if (m_block_nodes.count() > 0 && samples > 0)
+		step_block(samples);
+
+	if (UNEXPECTED(m_device.profiling()))
+		m_run_time += get_profile_ticks() - start;
+
 	if (m_samples == 0)
 	{
 		/* return and keep the task locked so it is not picked up by other worker threads */
@@ -303,14 +427,12 @@ void discrete_task::check(discrete_task *dest_task)
 					{
 						input_buffer source;
 						int i, found = -1;
-						output_buffer *pbuf = nullptr;
 
 						for (i = 0; i < m_buffers.count(); i++)
 //                          if (m_buffers[i].node->block_node() == inputnode_num)
 							if (m_buffers[i].node_num == inputnode_num)
 							{
 								found = i;
-								pbuf = &m_buffers[i];
 								break;
 							}
 
@@ -323,9 +445,10 @@ void discrete_task::check(discrete_task *dest_task)
 							buf.ptr = buf.node_buf;
 							buf.source = dest_node->m_input[inputnum];
 							buf.node_num = inputnode_num;
+							buf.block_output = nullptr;
 							//buf.node = device->discrete_find_node(inputnode);
-							m_buffers.count();
-							pbuf = m_buffers.add(buf);
+							found = m_buffers.count();
+							m_buffers.add(buf);
 						}
 						m_device.discrete_log("dso_task_start - buffering %d(%d) in task %p group %d referenced by %d group %d", NODE_INDEX(inputnode_num), NODE_CHILD_NODE_NUM(inputnode_num), this, task_group, dest_node->index(), dest_task->task_group);
 
@@ -333,14 +456,14 @@ void discrete_task::check(discrete_task *dest_task)
 						//source = auto_alloc(device->machine(), discrete_source_node);
 						//source.task = this;
 						//source.output_node = i;
-						source.linked_outbuf = pbuf;
+						source.linked_outbuf = nullptr;
 						source.buffer = 0.0; /* please compiler */
 						source.ptr = nullptr;
+						source.linked_task = this;
+						source.linked_index = found;
+						source.input = &dest_node->m_input[inputnum];
 						dest_task->source_list.add(source);
 
-						/* point the input to a buffered location */
-						dest_node->m_input[inputnum] = &dest_task->source_list[dest_task->source_list.count()-1].buffer; // was copied!   &source.buffer;
-
 					}
 				}
 			}
@@ -348,6 +471,17 @@ void discrete_task::check(discrete_task *dest_task)
 	}
 }
 
+/* point each buffered input at its source entry and each source at
+ * its output buffer, once no more entries are being added */
+void discrete_task::link_sources(void)
+{
+	for_each(input_buffer *, sn, &source_list)
+	{
+		sn->linked_outbuf = &sn->linked_task->m_buffers[sn->linked_index];
+		*sn->input = &sn->buffer;
+	}
+}
+
 /*************************************
  *
  *  Base node implementation
@@ -361,6 +495,7 @@ discrete_base_node::discrete_base_node() :
 	m_custom(nullptr),
 	m_input_is_node(0),
 	m_step_intf(nullptr),
+	m_block_intf(nullptr),
 	m_input_intf(nullptr),
 	m_output_intf(nullptr)
 {
@@ -382,6 +517,7 @@ void discrete_base_node::init(discrete_device *pdev, const discrete_block *xbloc
 	m_active_inputs = m_block->active_inputs;
 
 	m_step_intf = dynamic_cast<discrete_step_interface *>(this);
+	m_block_intf = dynamic_cast<discrete_block_step_interface *>(this);
 	m_input_intf = dynamic_cast<discrete_input_interface *>(this);
 	m_output_intf = dynamic_cast<discrete_sound_output_interface *>(this);
 
@@ -663,7 +799,8 @@ void discrete_device::display_profiling(void)
 	{
 		tt =  step_list_run_time((*task)->step_list);
 
-		printf("Task(%d): %8.2f %15.2f\n", (*task)->task_group, tt / (double) total * 100.0, tt / (double) m_total_samples);
+		printf("Task(%d): %8.2f %15.2f  nodes %3d  wall %12.2f  slices %8d  stalls %8d\n", (*task)->task_group, tt / (double) total * 100.0, tt / (double) m_total_samples,
+				(*task)->step_list.count(), (double) (*task)->m_run_time / (double) m_total_samples, (*task)->m_slices, (*task)->m_stalls);
 	}
 
 	printf("Average samples/double->update: %8.2f\n", (double) m_total_samples / (double) m_total_stream_updates);
@@ -793,6 +930,340 @@ void discrete_device::init_nodes(const sound_block_list_t &block_list)
 }
 
 
+/*************************************
+ *
+ *  Automatic task partitioning
+ *
+ *************************************/
+
+/* A few modules link to other nodes directly through their info
+ * structure. Those links are not redirected to task buffers, so
+ * the nodes involved have to end up in the same task.
+ */
+static int hidden_input_nodes(discrete_base_node *node, int *nodes)
+{
+	int count = 0;
+
+	if (dynamic_cast<DISCRETE_CLASS_NAME(dst_mixer) *>(node) != nullptr)
+	{
+		const discrete_mixer_desc *info = (const discrete_mixer_desc *) node->custom_data();
+		for (int i = 0; i < DISC_MAX_MIXER_INPUTS; i++)
+			if (IS_VALUE_A_NODE(info->r_node[i]))
+				nodes[count++] = info->r_node[i];
+	}
+	else if (dynamic_cast<DISCRETE_CLASS_NAME(dsd_555_astbl) *>(node) != nullptr)
+	{
+		const discrete_555_desc *info = (const discrete_555_desc *) node->custom_data();
+		if (IS_VALUE_A_NODE(info->v_charge))
+			nodes[count++] = (int) info->v_charge;
+	}
+	else if (dynamic_cast<DISCRETE_CLASS_NAME(dss_op_amp_osc) *>(node) != nullptr)
+	{
+		const discrete_op_amp_osc_info *info = (const discrete_op_amp_osc_info *) node->custom_data();
+		const double *r = &info->r1;
+		for (int i = 0; i < 8; i++)
+			if (IS_VALUE_A_NODE(r[i]))
+				nodes[count++] = (int) r[i];
+	}
+	return count;
+}
+
+static int find_root(std::vector<int> &parent, int i)
+{
+	while (parent[i] != i)
+		i = parent[i] = parent[parent[i]];
+	return i;
+}
+
+void discrete_device::auto_partition_tasks(void)
+{
+	node_step_list_t &steps = task_list[0]->step_list;
+	int count = steps.count();
+
+	/* explicit tasks always win */
+	for_each(discrete_base_node **, node, &m_node_list)
+		if ((*node)->module_type() == DSO_TASK_START)
+			return;
+
+	if (count < 2 * DISCRETE_AUTO_MIN_TASK_NODES)
+		return;
+
+	/* position of every stepping node in the running order */
+	std::vector<int> pos(DISCRETE_MAX_NODES, -1);
+	for (int i = 0; i < count; i++)
+	{
+		int node = steps[i]->self->block_node();
+		if (node != NODE_SPECIAL)
+			pos[NODE_INDEX(node)] = i;
+	}
+
+	/* collect references between stepping nodes */
+	struct node_ref { int from, to; bool hidden; };
+	std::vector<node_ref> refs;
+	for (int i = 0; i < count; i++)
+	{
+		discrete_base_node *node = steps[i]->self;
+		int hidden[DISC_MAX_MIXER_INPUTS > 8 ? DISC_MAX_MIXER_INPUTS : 8];
+		int num_hidden = hidden_input_nodes(node, hidden);
+
+		for (int inputnum = 0; inputnum < node->active_inputs(); inputnum++)
+		{
+			int inputnode = node->input_node(inputnum);
+			if (IS_VALUE_A_NODE(inputnode) && inputnode < NODE_SPECIAL && pos[NODE_INDEX(inputnode)] >= 0)
+				refs.push_back({ i, pos[NODE_INDEX(inputnode)], false });
+		}
+		for (int h = 0; h < num_hidden; h++)
+			if (hidden[h] < NODE_SPECIAL && pos[NODE_INDEX(hidden[h])] >= 0)
+				refs.push_back({ i, pos[NODE_INDEX(hidden[h])], true });
+	}
+
+	/* the final task starts out with the output and logging nodes.
+	 * If everything else is one connected graph, keep moving the
+	 * nodes nobody else consumes (usually mixers and output filters)
+	 * into the final task until the graph falls apart into branches.
+	 */
+	std::vector<bool> in_final(count, false);
+	std::vector<int> parent(count);
+	for (int i = 0; i < count; i++)
+		in_final[i] = (steps[i]->self->block_node() == NODE_SPECIAL);
+
+	int branches = 0;
+	for (int peel = 0; ; peel++)
+	{
+		for (int i = 0; i < count; i++)
+			parent[i] = i;
+		for (auto &ref : refs)
+			if (!in_final[ref.from] && !in_final[ref.to])
+				parent[find_root(parent, ref.from)] = find_root(parent, ref.to);
+
+		branches = 0;
+		for (int i = 0; i < count; i++)
+			if (!in_final[i] && find_root(parent, i) == i)
+				branches++;
+		if (branches >= 2 || peel == DISCRETE_AUTO_MAX_PEEL)
+			break;
+
+		std::vector<bool> consumed(count, false);
+		for (auto &ref : refs)
+			if (!in_final[ref.from] && ref.from != ref.to)
+				consumed[ref.to] = true;
+		for (int i = 0; i < count; i++)
+			if (!in_final[i] && !consumed[i])
+				in_final[i] = true;
+	}
+	if (branches < 2)
+		return;
+
+	/* A branch must only feed the final task, and only through nodes
+	 * which run earlier than their consumer: buffering turns a read of
+	 * the previous sample into a read of the current one.
+	 */
+	std::vector<bool> merge(count, false);
+	std::vector<int> size(count, 0);
+	for (int i = 0; i < count; i++)
+		if (!in_final[i])
+			size[find_root(parent, i)]++;
+	for (auto &ref : refs)
+	{
+		if (!in_final[ref.from] && in_final[ref.to])
+			merge[find_root(parent, ref.from)] = true;
+		else if (in_final[ref.from] && !in_final[ref.to] && (ref.hidden || ref.to > ref.from))
+			merge[find_root(parent, ref.to)] = true;
+	}
+
+	std::vector<int> roots;
+	for (int i = 0; i < count; i++)
+		if (!in_final[i] && find_root(parent, i) == i)
+		{
+			if (merge[i] || size[i] < DISCRETE_AUTO_MIN_TASK_NODES)
+				merge[i] = true;
+			else
+				roots.push_back(i);
+		}
+	if (roots.size() < 2)
+		return;
+
+	/* distribute the branches, largest first, onto the least loaded task */
+	std::sort(roots.begin(), roots.end(), [&size](int a, int b) { return size[a] > size[b]; });
+	int num_tasks = MIN((int) roots.size(), DISCRETE_AUTO_MAX_TASKS);
+	std::vector<int> load(num_tasks, 0);
+	std::vector<int> bucket(count, -1);
+	for (int root : roots)
+	{
+		int best = std::min_element(load.begin(), load.end()) - load.begin();
+		load[best] += size[root];
+		bucket[root] = best;
+	}
+
+	/* rebuild the task list, keeping the original running order within each task */
+	discrete_task *final_task = task_list[0];
+	std::vector<discrete_task *> tasks(num_tasks);
+	node_step_list_t all_steps = steps;
+
+	task_list.clear();
+	for (int t = 0; t < num_tasks; t++)
+	{
+		tasks[t] = auto_alloc_clear(machine(), <discrete_task>(*this));
+		tasks[t]->task_group = 0;
+		task_list.add(tasks[t]);
+	}
+	final_task->task_group = 1;
+	final_task->step_list.clear();
+	task_list.add(final_task);
+
+	for (int i = 0; i < count; i++)
+	{
+		int root = find_root(parent, i);
+		if (in_final[i] || merge[root])
+			final_task->step_list.add(all_steps[i]);
+		else
+			tasks[bucket[root]]->step_list.add(all_steps[i]);
+	}
+
+	for (int t = 0; t < task_list.count(); t++)
+	{
+		discrete_log("auto task %d: group %d, %d nodes", t, task_list[t]->task_group, task_list[t]->step_list.count());
+		if (m_profiling)
+			printf("Auto task %d: group %d, %d nodes\n", t, task_list[t]->task_group, task_list[t]->step_list.count());
+	}
+}
+
+
+/*************************************
+ *
+ *  Block stepping
+ *
+ *************************************/
+
+static int step_list_position(const node_step_list_t &list, int node)
+{
+	for (int i = 0; i < list.count(); i++)
+		if (list[i]->self->block_node() == NODE_DEFAULT_NODE(node))
+			return i;
+	return -1;
+}
+
+static bool node_references(discrete_base_node *node, int target)
+{
+	int hidden[DISC_MAX_MIXER_INPUTS > 8 ? DISC_MAX_MIXER_INPUTS : 8];
+	int num_hidden = hidden_input_nodes(node, hidden);
+
+	for (int inputnum = 0; inputnum < node->active_inputs(); inputnum++)
+		if (IS_VALUE_A_NODE(node->input_node(inputnum)) && NODE_DEFAULT_NODE(node->input_node(inputnum)) == target)
+			return true;
+	for (int h = 0; h < num_hidden; h++)
+		if (NODE_DEFAULT_NODE(hidden[h]) == target)
+			return true;
+	return false;
+}
+
+void discrete_task::setup_block_stepping(void)
+{
+	int count = step_list.count();
+	int start = count;
+
+	m_step_count = count;
+	if (!USE_DISCRETE_BLOCK_STEPPING)
+		return;
+
+	/* find the longest tail of nodes without feedback which can be block stepped */
+	for (int j = count - 1; j >= 0; j--)
+	{
+		discrete_base_node *node = step_list[j]->self;
+		discrete_block_step_interface *block;
+		int hidden[DISC_MAX_MIXER_INPUTS > 8 ? DISC_MAX_MIXER_INPUTS : 8];
+		bool ok = true;
+
+		/* links through the info structure are read live, so they rule out block stepping */
+		if (!node->interface(block) || node->max_output() > 1 || hidden_input_nodes(node, hidden) > 0)
+			break;
+
+		/* all inputs have to be computed before this node ... */
+		for (int inputnum = 0; inputnum < node->active_inputs(); inputnum++)
+			if (IS_VALUE_A_NODE(node->input_node(inputnum)) && step_list_position(step_list, node->input_node(inputnum)) >= j)
+				ok = false;
+
+		/* ... and nothing computed before may use its output */
+		if (node->block_node() != NODE_SPECIAL)
+			for (int k = 0; k < j && ok; k++)
+				if (node_references(step_list[k]->self, node->block_node()))
+					ok = false;
+
+		if (!ok)
+			break;
+		start = j;
+	}
+
+	if (count - start < DISCRETE_MIN_BLOCK_NODES)
+		return;
+
+	m_step_count = start;
+	for (int j = start; j < count; j++)
+	{
+		discrete_base_node *node = step_list[j]->self;
+		block_node bn;
+
+		node->interface(bn.node);
+		bn.step = step_list[j];
+		bn.output = auto_alloc_array_clear(m_device.machine(), double, MAX_SAMPLES_PER_TASK_SLICE);
+
+		for (int inputnum = 0; inputnum < DISCRETE_MAX_INPUTS; inputnum++)
+		{
+			const double *source = node->m_input[inputnum];
+			const double *buffer = nullptr;
+
+			/* produced by another block stepped node? */
+			for (int k = 0; k < m_block_nodes.count() && buffer == nullptr; k++)
+				if (source == &m_block_nodes[k].step->self->m_output[0])
+					buffer = m_block_nodes[k].output;
+
+			if (buffer == nullptr && (inputnum >= node->active_inputs() || !(node->input_is_node() & (1 << inputnum))))
+			{
+				/* static value, fill once */
+				double value = (source != nullptr) ? *source : 0.0;
+				for (int k = 0; k < m_block_constants.count() && buffer == nullptr; k++)
+					if (m_block_constants[k][0] == value)
+						buffer = m_block_constants[k];
+				if (buffer == nullptr)
+				{
+					double *constant = auto_alloc_array(m_device.machine(), double, MAX_SAMPLES_PER_TASK_SLICE);
+					for (int i = 0; i < MAX_SAMPLES_PER_TASK_SLICE; i++)
+						constant[i] = value;
+					m_block_constants.add(constant);
+					buffer = constant;
+				}
+			}
+
+			if (buffer == nullptr)
+			{
+				/* changes every sample, capture it while stepping */
+				for (int k = 0; k < m_block_captures.count() && buffer == nullptr; k++)
+					if (m_block_captures[k].source == source)
+						buffer = m_block_captures[k].buffer;
+				if (buffer == nullptr)
+				{
+					block_capture cap;
+					cap.source = source;
+					cap.buffer = auto_alloc_array_clear(m_device.machine(), double, MAX_SAMPLES_PER_TASK_SLICE);
+					m_block_captures.add(cap);
+					buffer = cap.buffer;
+				}
+			}
+			bn.inputs[inputnum] = buffer;
+		}
+		m_block_nodes.add(bn);
+	}
+
+	/* outputs needed by other tasks are copied once per slice */
+	for_each(output_buffer *, outbuf, &m_buffers)
+		for_each(block_node *, bn, &m_block_nodes)
+			if (outbuf->source == &bn->step->self->m_output[0])
+				outbuf->block_output = bn->output;
+
+	m_device.discrete_log("task group %d: %d of %d nodes block stepped", task_group, count - start, count);
+}
+
+
 /*************************************
  *
  *  node_description implementation
@@ -915,6 +1386,10 @@ void discrete_device::device_start()
 		(*node)->resolve_input_nodes();
 	}
 
+	/* split a netlist without explicit tasks into parallel branches */
+	if (USE_DISCRETE_TASKS && machine().options().discrete_auto_tasks() && task_list.count() == 1)
+		auto_partition_tasks();
+
 	/* allocate a queue */
 	m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
@@ -933,6 +1408,12 @@ void discrete_device::device_start()
 				(*dest_task)->check((*task));
 		}
 	}
+	for_each(discrete_task **, task, &task_list)
+		(*task)->link_sources();
+
+	/* and decide which nodes can be stepped a slice at a time */
+	for_each(discrete_task **, task, &task_list)
+		(*task)->setup_block_stepping();
 }
 
 void discrete_device::device_stop()
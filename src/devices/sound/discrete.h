@@ -3499,6 +3499,7 @@
 #define DISCRETE_CLASS_FUNC(_class, _func)      DISCRETE_CLASS_NAME(_class) :: _func
 
 #define DISCRETE_STEP(_class)                   void DISCRETE_CLASS_FUNC(_class, step)(void)
+#define DISCRETE_STEP_BLOCK(_class)             void DISCRETE_CLASS_FUNC(_class, step_block)(const double * const *inputs, double *output, int samples)
 #define DISCRETE_RESET(_class)                  void DISCRETE_CLASS_FUNC(_class, reset)(void)
 #define DISCRETE_START(_class)                  void DISCRETE_CLASS_FUNC(_class, start)(void)
 #define DISCRETE_STOP(_class)                   void DISCRETE_CLASS_FUNC(_class, stop)(void)
@@ -4237,6 +4238,17 @@ public:
 };
 typedef vector_t<discrete_step_interface *> node_step_list_t;
 
+/* Nodes without feedback may process a whole slice at once.
+ * Input n of sample i is inputs[n][i], output 0 goes to output[i].
+ */
+class discrete_block_step_interface
+{
+public:
+	virtual ~discrete_block_step_interface() { }
+
+	virtual void step_block(const double * const *inputs, double *output, int samples) = 0;
+};
+
 class discrete_input_interface
 {
 public:
@@ -4347,6 +4359,7 @@ private:
 	void discrete_sanity_check(const sound_block_list_t &block_list);
 	void display_profiling(void);
 	void init_nodes(const sound_block_list_t &block_list);
+	void auto_partition_tasks(void);
 
 	/* internal node tracking */
 	discrete_base_node **   m_indexed_node;
@@ -4425,6 +4438,7 @@ public:
 	virtual int max_output(void) { return 1; };
 
 	inline bool interface(discrete_step_interface *&intf) const { intf = m_step_intf; return (intf != nullptr); }
+	inline bool interface(discrete_block_step_interface *&intf) const { intf = m_block_intf; return (intf != nullptr); }
 	inline bool interface(discrete_input_interface *&intf) const { intf = m_input_intf; return (intf != nullptr); }
 	inline bool interface(discrete_sound_output_interface *&intf) const { intf = m_output_intf; return (intf != nullptr); }
 
@@ -4466,6 +4480,24 @@ protected:
 
 	void resolve_input_nodes(void);
 
+	/* block stepping for nodes whose step() has no faster equivalent */
+	template <class _Node> void step_block_generic(_Node *node, const double * const *inputs, double *output, int samples)
+	{
+		const double *saved[DISCRETE_MAX_INPUTS];
+
+		for (int n = 0; n < m_active_inputs; n++)
+			saved[n] = m_input[n];
+		for (int i = 0; i < samples; i++)
+		{
+			for (int n = 0; n < m_active_inputs; n++)
+				m_input[n] = &inputs[n][i];
+			node->_Node::step();
+			output[i] = m_output[0];
+		}
+		for (int n = 0; n < m_active_inputs; n++)
+			m_input[n] = saved[n];
+	}
+
 	double                          m_output[DISCRETE_MAX_OUTPUTS];     /* The node's last output value */
 	const double *                  m_input[DISCRETE_MAX_INPUTS];       /* Addresses of Input values */
 	discrete_device *               m_device;                           /* Points to the parent */
@@ -4479,6 +4511,7 @@ private:
 	int                             m_input_is_node;
 
 	discrete_step_interface *       m_step_intf;
+	discrete_block_step_interface * m_block_intf;
 	discrete_input_interface *      m_input_intf;
 	discrete_sound_output_interface *       m_output_intf;
 };
@@ -61,6 +61,7 @@
 #define POLYFLAG_INCLUDE_BOTTOM_EDGE        0x01
 #define POLYFLAG_INCLUDE_RIGHT_EDGE         0x02
 #define POLYFLAG_NO_WORK_QUEUE              0x04
+#define POLYFLAG_BINNED                     0x08        // defer rendering until wait(), one work item per bucket
 
 #define SCANLINES_PER_BUCKET                8
 #define CACHE_LINE_SIZE                     64          // this is a general guess
@@ -121,6 +122,17 @@ public:
 	// delegate type for scanline callbacks
 	typedef delegate<void (INT32, const extent_t &, const _ObjectData &, int)> render_delegate;
 
+	// rendering statistics, accumulated per frame
+	struct statistics
+	{
+		UINT32 tiles;                           // number of tiles queued
+		UINT32 triangles;                       // number of triangles queued
+		UINT32 quads;                           // number of quads queued
+		UINT64 pixels;                          // number of pixels rendered
+		UINT32 waits;                           // number of calls to wait()
+		osd_ticks_t wait_ticks;                 // time spent waiting for rendering to complete
+	};
+
 	// construction/destruction
 	poly_manager(running_machine &machine, UINT8 flags = 0);
 	poly_manager(screen_device &screen, UINT8 flags = 0);
@@ -133,6 +145,9 @@ public:
 	// synchronization
 	void wait(const char *debug_reason = "general");
 
+	// statistics
+	const statistics &frame_stats() const { return m_last_frame_stats; }
+
 	// object data allocators
 	_ObjectData &object_data_alloc();
 	_ObjectData &object_data_last() const { return m_object.last(); }
@@ -250,7 +265,19 @@ private:
 		return polygon;
 	}
 
+	// a bucket's list of work units, handed to a single worker in binned mode
+	struct bin_info
+	{
+		poly_manager *      m_owner;                // pointer back to the poly manager
+		UINT16              m_head;                 // index of the first unit in the bucket
+	};
+
+	void queue_units(UINT32 startunit);
+	void flush_bins();
+	void update_frame_stats();
+
 	static void *work_item_callback(void *param, int threadid);
+	static void *bin_item_callback(void *param, int threadid);
 	void presave() { wait("pre-save"); }
 
 	// queue management
@@ -268,12 +295,19 @@ private:
 
 	// buckets
 	UINT16              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
+	UINT16              m_bin_head[TOTAL_BUCKETS];  // first deferred unit in each bucket (binned mode)
+	UINT16              m_bin_tail[TOTAL_BUCKETS];  // last deferred unit in each bucket (binned mode)
+	bin_info            m_bin[TOTAL_BUCKETS];       // per-bucket work items (binned mode)
 
 	// statistics
 	UINT32              m_tiles;                    // number of tiles queued
 	UINT32              m_triangles;                // number of triangles queued
 	UINT32              m_quads;                    // number of quads queued
 	UINT64              m_pixels;                   // number of pixels rendered
+	osd_ticks_t         m_wait_ticks;               // total time spent waiting
+	UINT64              m_stats_frame;              // frame number m_frame_stats applies to
+	statistics          m_frame_stats;              // statistics for the current frame
+	statistics          m_last_frame_stats;         // statistics for the last complete frame
 #if KEEP_POLY_STATISTICS
 	UINT32              m_conflicts[WORK_MAX_THREADS]; // number of conflicts found, per thread
 	UINT32              m_resolved[WORK_MAX_THREADS];   // number of conflicts resolved, per thread
@@ -294,14 +328,22 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 		m_object(machine, *this),
 		m_unit(machine, *this),
 		m_flags(flags),
+		m_tiles(0),
 		m_triangles(0),
 		m_quads(0),
-		m_pixels(0)
+		m_pixels(0),
+		m_wait_ticks(0),
+		m_stats_frame(0)
 {
 #if KEEP_POLY_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
 #endif
+	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+	memset(m_bin_head, 0xff, sizeof(m_bin_head));
+	memset(m_bin_tail, 0xff, sizeof(m_bin_tail));
+	memset(&m_frame_stats, 0, sizeof(m_frame_stats));
+	memset(&m_last_frame_stats, 0, sizeof(m_last_frame_stats));
 
 	// create the work queue
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
@@ -321,14 +363,22 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen
 		m_object(screen.machine(), *this),
 		m_unit(screen.machine(), *this),
 		m_flags(flags),
+		m_tiles(0),
 		m_triangles(0),
 		m_quads(0),
-		m_pixels(0)
+		m_pixels(0),
+		m_wait_ticks(0),
+		m_stats_frame(0)
 {
 #if KEEP_POLY_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
 #endif
+	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+	memset(m_bin_head, 0xff, sizeof(m_bin_head));
+	memset(m_bin_tail, 0xff, sizeof(m_bin_tail));
+	memset(&m_frame_stats, 0, sizeof(m_frame_stats));
+	memset(&m_last_frame_stats, 0, sizeof(m_last_frame_stats));
 
 	// create the work queue
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
@@ -357,6 +407,7 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 	}
 
 	// output global stats
+	printf("Total tiles     = %d\n", m_tiles);
 	printf("Total triangles = %d\n", m_triangles);
 	printf("Total quads = %d\n", m_quads);
 	if (m_pixels > 1000000000)
@@ -364,6 +415,7 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 	else
 		printf("Total pixels   = %d\n", (UINT32)m_pixels);
 
+	printf("Wait time:   %.3f seconds\n", (double)m_wait_ticks / (double)osd_ticks_per_second());
 	printf("Conflicts:   %d resolved, %d total\n", resolved, conflicts);
 	printf("Units:       %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_unit.max(), m_unit.allocated(), m_unit.waits(), m_unit.itemsize(), m_unit.allocated() * m_unit.itemsize());
 	printf("Polygons:    %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_polygon.max(), m_polygon.allocated(), m_polygon.waits(), m_polygon.itemsize(), m_polygon.allocated() * m_polygon.itemsize());
@@ -439,6 +491,121 @@ void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_cal
 }
 
 
+//-------------------------------------------------
+//  bin_item_callback - process every unit in a
+//  single bucket, in submission order; the bucket
+//  is owned by this worker so no locking is needed
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::bin_item_callback(void *param, int threadid)
+{
+	bin_info &bin = *(bin_info *)param;
+	poly_manager &owner = *bin.m_owner;
+
+	for (UINT32 unitnum = bin.m_head; ; )
+	{
+		work_unit &unit = owner.m_unit[unitnum];
+		polygon_info &polygon = *unit.polygon;
+		int count = unit.count_next & 0xffff;
+
+		// iterate over extents
+		for (int curscan = 0; curscan < count; curscan++)
+			polygon.m_callback(unit.scanline + curscan, unit.extent[curscan], *polygon.m_object, threadid);
+
+		// the first unit is always a head, so 0 terminates the list
+		unitnum = unit.count_next >> 16;
+		if (unitnum == 0)
+			break;
+	}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  queue_units - hand newly built work units off
+//  for rendering
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::queue_units(UINT32 startunit)
+{
+	// in binned mode, append each unit to its bucket's list for later
+	if (m_flags & POLYFLAG_BINNED)
+	{
+		for (UINT32 unitnum = startunit; unitnum < m_unit.count(); unitnum++)
+		{
+			work_unit &unit = m_unit[unitnum];
+			UINT32 bucketnum = ((UINT32)unit.scanline / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+			if (m_bin_tail[bucketnum] == 0xffff)
+				m_bin_head[bucketnum] = unitnum;
+			else
+				m_unit[m_bin_tail[bucketnum]].count_next |= unitnum << 16;
+			m_bin_tail[bucketnum] = unitnum;
+		}
+	}
+
+	// otherwise, queue them up right away
+	else if (m_queue != nullptr)
+		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  flush_bins - render all the deferred buckets,
+//  one work item per non-empty bucket
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::flush_bins()
+{
+	// gather the non-empty buckets
+	int numbins = 0;
+	for (int bucketnum = 0; bucketnum < TOTAL_BUCKETS; bucketnum++)
+		if (m_bin_head[bucketnum] != 0xffff)
+		{
+			m_bin[numbins].m_owner = this;
+			m_bin[numbins].m_head = m_bin_head[bucketnum];
+			numbins++;
+		}
+
+	// render them on the queue if we have one, or inline if not
+	if (numbins > 0)
+	{
+		if (m_queue != nullptr)
+		{
+			osd_work_item_queue_multiple(m_queue, bin_item_callback, numbins, &m_bin[0], sizeof(m_bin[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+		}
+		else
+			for (int binnum = 0; binnum < numbins; binnum++)
+				bin_item_callback(&m_bin[binnum], 0);
+	}
+
+	memset(m_bin_head, 0xff, sizeof(m_bin_head));
+	memset(m_bin_tail, 0xff, sizeof(m_bin_tail));
+}
+
+
+//-------------------------------------------------
+//  update_frame_stats - roll the statistics over
+//  at the start of each new frame
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::update_frame_stats()
+{
+	screen_device *screen = (m_screen != nullptr) ? m_screen : machine().first_screen();
+	UINT64 frame = (screen != nullptr) ? screen->frame_number() : 0;
+	if (frame != m_stats_frame)
+	{
+		m_last_frame_stats = m_frame_stats;
+		memset(&m_frame_stats, 0, sizeof(m_frame_stats));
+		m_stats_frame = frame;
+	}
+}
+
+
 //-------------------------------------------------
 //  wait - stall until all work is complete
 //-------------------------------------------------
@@ -451,9 +618,14 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	// remember the start time if we're logging
 	if (LOG_WAITS)
 		time = get_profile_ticks();
+	osd_ticks_t wait_start = osd_ticks();
+
+	// in binned mode, render everything that was deferred
+	if (m_flags & POLYFLAG_BINNED)
+		flush_bins();
 
 	// wait for all pending work items to complete
-	if (m_queue != nullptr)
+	else if (m_queue != nullptr)
 		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
 
 	// if we don't have a queue, just run the whole list now
@@ -469,6 +641,13 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 			machine().logerror("Poly:Waited %d cycles for %s\n", (int)time, debug_reason);
 	}
 
+	// accumulate wait statistics
+	osd_ticks_t wait_ticks = osd_ticks() - wait_start;
+	update_frame_stats();
+	m_wait_ticks += wait_ticks;
+	m_frame_stats.wait_ticks += wait_ticks;
+	m_frame_stats.waits++;
+
 	// reset the state
 	m_polygon.reset();
 	m_unit.reset();
@@ -620,12 +799,14 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_tiles++;
 	m_pixels += pixels;
+	update_frame_stats();
+	m_frame_stats.tiles++;
+	m_frame_stats.pixels += pixels;
 	return pixels;
 }
 
@@ -808,12 +989,14 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_triangles++;
 	m_pixels += pixels;
+	update_frame_stats();
+	m_frame_stats.triangles++;
+	m_frame_stats.pixels += pixels;
 	return pixels;
 }
 
@@ -924,12 +1107,14 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the object
 	m_triangles++;
 	m_pixels += pixels;
+	update_frame_stats();
+	m_frame_stats.triangles++;
+	m_frame_stats.pixels += pixels;
 	return pixels;
 }
 
@@ -1123,12 +1308,14 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polyg
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_quads++;
 	m_pixels += pixels;
+	update_frame_stats();
+	m_frame_stats.quads++;
+	m_frame_stats.pixels += pixels;
 	return pixels;
 }
 
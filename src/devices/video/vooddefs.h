@@ -2659,6 +2659,9 @@ static inline bool ATTR_FORCE_INLINE combineColor(voodoo_device *vd, stats_block
 #define RASTERIZER(name, TMUS, FBZCOLORPATH, FBZMODE, ALPHAMODE, FOGMODE, TEXMODE0, TEXMODE1) \
 																				\
 void voodoo_device::raster_##name(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid) \
+RASTERIZER_BODY(TMUS, FBZCOLORPATH, FBZMODE, ALPHAMODE, FOGMODE, TEXMODE0, TEXMODE1)
+
+#define RASTERIZER_BODY(TMUS, FBZCOLORPATH, FBZMODE, ALPHAMODE, FOGMODE, TEXMODE0, TEXMODE1) \
 {                                                                               \
 	const poly_extra_data *extra = (const poly_extra_data *)extradata;          \
 	voodoo_device *vd = extra->device; \
@@ -148,6 +148,8 @@ bits(7:4) and bit(24)), X, and Y:
 #include "voodoo.h"
 #include "vooddefs.h"
 
+#include <algorithm>
+
 
 /*************************************
  *
@@ -5676,8 +5678,8 @@ raster_info *voodoo_device::find_rasterizer(voodoo_device *vd, int texcount)
 			return info;
 		}
 
-	/* generate a new one using the generic entry */
-	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
+	/* not seen before: cache it with the matching specialized rasterizer */
+	curinfo.callback = select_specialized_rasterizer(&curinfo, texcount);
 	curinfo.is_generic = TRUE;
 	curinfo.display = 0;
 	curinfo.polys = 0;
@@ -5736,6 +5738,69 @@ void voodoo_device::dump_rasterizer_stats(voodoo_device *vd)
 	}
 }
 
+
+/*-------------------------------------------------
+    report_rasterizer_stats - summarize how much
+    work went through the compiled rasterizers
+    vs. the specialized ones cached on first use,
+    and list the cached combinations in a form
+    suitable for pasting into voodoo_rast.inc
+-------------------------------------------------*/
+
+void voodoo_device::report_rasterizer_stats(voodoo_device *vd)
+{
+	UINT64 total_polys = 0, total_hits = 0;
+	UINT64 generic_polys = 0, generic_hits = 0;
+	int generic_count = 0;
+
+	/* accumulate totals */
+	for (int index = 0; index < vd->next_rasterizer; index++)
+	{
+		const raster_info &info = vd->rasterizer[index];
+		total_polys += info.polys;
+		total_hits += info.hits;
+		if (info.is_generic && info.polys != 0)
+		{
+			generic_polys += info.polys;
+			generic_hits += info.hits;
+			generic_count++;
+		}
+	}
+	if (total_polys == 0)
+		return;
+
+	osd_printf_verbose("%s: %d rasterizers used; compiled: %" I64FMT "u polygons, %" I64FMT "u scanlines; specialized: %" I64FMT "u polygons, %" I64FMT "u scanlines\n",
+		vd->device->tag(), vd->next_rasterizer,
+		total_polys - generic_polys, total_hits - generic_hits, generic_polys, generic_hits);
+	if (generic_count == 0)
+		return;
+
+	/* each combination fills the dispatch cache on its first polygon; the rest are cache hits */
+	osd_printf_verbose("%s: %d combinations outside voodoo_rast.inc, %" I64FMT "u dispatch cache hits (%.1f%% of polygons, %.1f%% of scanlines)\n",
+		vd->device->tag(), generic_count, generic_polys - generic_count,
+		100.0 * (double)generic_polys / (double)total_polys,
+		(total_hits != 0) ? 100.0 * (double)generic_hits / (double)total_hits : 0.0);
+
+	/* list the cached combinations from most to least used */
+	std::vector<const raster_info *> generic;
+	for (int index = 0; index < vd->next_rasterizer; index++)
+		if (vd->rasterizer[index].is_generic && vd->rasterizer[index].polys != 0)
+			generic.push_back(&vd->rasterizer[index]);
+	std::sort(generic.begin(), generic.end(), [](const raster_info *a, const raster_info *b) { return a->hits > b->hits; });
+
+	osd_printf_verbose("/* %-10s > fbzColorPath alphaMode   fogMode,    fbzMode,    texMode0,   texMode1  */\n", vd->machine().system().name);
+	for (const raster_info *info : generic)
+		osd_printf_verbose("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) /* * %8d %10d */\n",
+			info->eff_color_path,
+			info->eff_alpha_mode,
+			info->eff_fog_mode,
+			info->eff_fbz_mode,
+			info->eff_tex_mode_0,
+			info->eff_tex_mode_1,
+			info->polys,
+			info->hits);
+}
+
 voodoo_device::voodoo_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source)
 	: device_t(mconfig, type, name, tag, owner, clock, shortname, source),
 		m_fbmem(0),
@@ -5780,6 +5845,10 @@ void voodoo_device::device_stop()
 	/* release the work queue, ensuring all work is finished */
 	if (poly != nullptr)
 		poly_free(poly);
+
+	/* report which rasterizers were used */
+	if (machine().options().verbose())
+		report_rasterizer_stats(this);
 }
 
 
@@ -5914,24 +5983,76 @@ void voodoo_device::raster_fastfill(void *destbase, INT32 y, const poly_extent *
 
 
 /*-------------------------------------------------
-    generic_0tmu - generic rasterizer for 0 TMUs
+    specialized rasterizers - combinations which
+    are not in voodoo_rast.inc are drawn by one of
+    these; the mode bits that gate the costly parts
+    of the pixel pipeline are compiled in from
+    FEATURES, and the rest of each mode is read
+    from the raster_info the polygon was set up
+    with
 -------------------------------------------------*/
 
-RASTERIZER(generic_0tmu, 0, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
-			vd->reg[fogMode].u, 0, 0)
-
-
-/*-------------------------------------------------
-    generic_1tmu - generic rasterizer for 1 TMU
--------------------------------------------------*/
+#define RASTER_FEATURE_DEPTHBUF     0x01    /* fbzMode: depth buffering enabled */
+#define RASTER_FEATURE_ALPHATEST    0x02    /* alphaMode: alpha test enabled */
+#define RASTER_FEATURE_ALPHABLEND   0x04    /* alphaMode: alpha blending enabled */
+#define RASTER_FEATURE_FOG          0x08    /* fogMode: fog enabled */
+#define RASTER_FEATURE_PERSPECTIVE  0x10    /* textureMode (TMU #0): perspective correction enabled */
+#define RASTER_FEATURE_COUNT        0x20
+
+/* replace the bits in mask with the compile-time value of the feature */
+#define RASTER_FEATURE_MODE(mode, mask, feature) \
+	(((mode) & ~(mask)) | ((FEATURES & (feature)) ? (mask) : 0))
+
+template<int TMUS, int FEATURES>
+void voodoo_device::raster_specialized(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid)
+RASTERIZER_BODY(TMUS,
+		extra->info->eff_color_path,
+		RASTER_FEATURE_MODE(extra->info->eff_fbz_mode, 0x00000010, RASTER_FEATURE_DEPTHBUF),
+		RASTER_FEATURE_MODE(RASTER_FEATURE_MODE(extra->info->eff_alpha_mode, 0x00000001, RASTER_FEATURE_ALPHATEST), 0x00000010, RASTER_FEATURE_ALPHABLEND),
+		RASTER_FEATURE_MODE(extra->info->eff_fog_mode, 0x00000001, RASTER_FEATURE_FOG),
+		(TMUS >= 1) ? RASTER_FEATURE_MODE(extra->info->eff_tex_mode_0, 0x00000001, RASTER_FEATURE_PERSPECTIVE) : 0,
+		(TMUS >= 2) ? extra->info->eff_tex_mode_1 : 0)
+
+#define RASTER_SPECIALIZED_4(tmus, base) \
+	&voodoo_device::raster_specialized<tmus, (base) + 0>, &voodoo_device::raster_specialized<tmus, (base) + 1>, \
+	&voodoo_device::raster_specialized<tmus, (base) + 2>, &voodoo_device::raster_specialized<tmus, (base) + 3>
+#define RASTER_SPECIALIZED_16(tmus, base) \
+	RASTER_SPECIALIZED_4(tmus, (base) + 0), RASTER_SPECIALIZED_4(tmus, (base) + 4), \
+	RASTER_SPECIALIZED_4(tmus, (base) + 8), RASTER_SPECIALIZED_4(tmus, (base) + 12)
+
+/* without a TMU the perspective bit means nothing, so both halves share the same code */
+static const poly_draw_scanline_func specialized_raster_table[3][RASTER_FEATURE_COUNT] =
+{
+	{ RASTER_SPECIALIZED_16(0, 0), RASTER_SPECIALIZED_16(0, 0) },
+	{ RASTER_SPECIALIZED_16(1, 0), RASTER_SPECIALIZED_16(1, 16) },
+	{ RASTER_SPECIALIZED_16(2, 0), RASTER_SPECIALIZED_16(2, 16) }
+};
 
-RASTERIZER(generic_1tmu, 1, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
-			vd->reg[fogMode].u, vd->tmu[0].reg[textureMode].u, 0)
+#undef RASTER_SPECIALIZED_16
+#undef RASTER_SPECIALIZED_4
+#undef RASTER_FEATURE_MODE
 
 
 /*-------------------------------------------------
-    generic_2tmu - generic rasterizer for 2 TMUs
+    select_specialized_rasterizer - pick the
+    specialized rasterizer whose compiled-in
+    feature bits match a combination
 -------------------------------------------------*/
 
-RASTERIZER(generic_2tmu, 2, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
-			vd->reg[fogMode].u, vd->tmu[0].reg[textureMode].u, vd->tmu[1].reg[textureMode].u)
+poly_draw_scanline_func voodoo_device::select_specialized_rasterizer(const raster_info *info, int texcount)
+{
+	int features = 0;
+
+	if (FBZMODE_ENABLE_DEPTHBUF(info->eff_fbz_mode))
+		features |= RASTER_FEATURE_DEPTHBUF;
+	if (ALPHAMODE_ALPHATEST(info->eff_alpha_mode))
+		features |= RASTER_FEATURE_ALPHATEST;
+	if (ALPHAMODE_ALPHABLEND(info->eff_alpha_mode))
+		features |= RASTER_FEATURE_ALPHABLEND;
+	if (FOGMODE_ENABLE_FOG(info->eff_fog_mode))
+		features |= RASTER_FEATURE_FOG;
+	if (texcount >= 1 && TEXMODE_ENABLE_PERSPECTIVE(info->eff_tex_mode_0))
+		features |= RASTER_FEATURE_PERSPECTIVE;
+
+	return specialized_raster_table[texcount][features];
+}
@@ -1614,7 +1614,7 @@ struct raster_info
 {
 	raster_info *       next;                   /* pointer to next entry with the same hash */
 	poly_draw_scanline_func callback;           /* callback pointer */
-	UINT8               is_generic;             /* TRUE if this is one of the generic rasterizers */
+	UINT8               is_generic;             /* TRUE if not in voodoo_rast.inc (served by a specialized template) */
 	UINT8               display;                /* display index */
 	UINT32              hits;                   /* how many hits (pixels) we've used this for */
 	UINT32              polys;                  /* how many polys we've used this for */
@@ -1813,6 +1813,7 @@ public:
 	static raster_info *add_rasterizer(voodoo_device *vd, const raster_info *cinfo);
 	static raster_info *find_rasterizer(voodoo_device *vd, int texcount);
 	static void dump_rasterizer_stats(voodoo_device *vd);
+	static void report_rasterizer_stats(voodoo_device *vd);
 	static void init_tmu_shared(tmu_shared_state *s);
 
 	static void swap_buffers(voodoo_device *vd);
@@ -1821,9 +1822,9 @@ public:
 	static void cmdfifo_w(voodoo_device *vd, cmdfifo_info *f, offs_t offset, UINT32 data);
 
 	static void raster_fastfill(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_0tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_1tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_2tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
+	template<int TMUS, int FEATURES>
+	static void raster_specialized(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
+	static poly_draw_scanline_func select_specialized_rasterizer(const raster_info *info, int texcount);
 
 #define RASTERIZER_HEADER(name) \
 	static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid);
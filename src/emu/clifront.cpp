@@ -1792,30 +1792,52 @@ void media_identifier::identify(const char *filename)
 		_7z_error _7zerr = _7z_file_open(filename, &_7z);
 		if (_7zerr == _7ZERR_NONE && _7z != nullptr)
 		{
-			// loop over entries in the .7z, skipping empty files and directories
-			for (int i = 0; i < _7z->db.db.NumFiles; i++)
+			// loop over entries in the .7z, skipping empty files and directories, and
+			// decompress them into RAM in batches so solid blocks can be decoded in parallel
+			std::vector<_7z_decompress_request> requests;
+			std::vector<dynamic_buffer> buffers;
+			std::vector<std::string> names;
+			UINT64 batchbytes = 0;
+			for (int i = 0; i <= _7z->db.db.NumFiles; i++)
 			{
-				const CSzFileItem *f = _7z->db.db.Files + i;
-				_7z->curr_file_idx = i;
-				int namelen = SzArEx_GetFileNameUtf16(&_7z->db, i, nullptr);
-				std::vector<UINT16> temp(namelen);
-				dynamic_buffer temp2(namelen+1);
-				UINT8* temp3 = &temp2[0];
-				memset(temp3, 0x00, namelen);
-				SzArEx_GetFileNameUtf16(&_7z->db, i, &temp[0]);
-				// crude, need real UTF16->UTF8 conversion ideally
-				for (int j=0;j<namelen;j++)
+				if (i < _7z->db.db.NumFiles)
 				{
-					temp3[j] = (UINT8)temp[j];
+					const CSzFileItem *f = _7z->db.db.Files + i;
+					if (!(f->IsDir) && (f->Size != 0))
+					{
+						int namelen = SzArEx_GetFileNameUtf16(&_7z->db, i, nullptr);
+						std::vector<UINT16> temp(namelen);
+						std::string temp2(namelen, '\0');
+						SzArEx_GetFileNameUtf16(&_7z->db, i, &temp[0]);
+						// crude, need real UTF16->UTF8 conversion ideally
+						for (int j=0;j<namelen;j++)
+						{
+							temp2[j] = (char)temp[j];
+						}
+
+						_7z_decompress_request request;
+						request.index = i;
+						request.length = f->Size;
+						requests.push_back(request);
+						buffers.emplace_back(f->Size);
+						names.push_back(temp2.c_str());
+						batchbytes += f->Size;
+					}
 				}
 
-				if (!(f->IsDir) && (f->Size != 0))
+				// identify the batch once it is large enough or all files have been seen
+				if (!requests.empty() && (i == _7z->db.db.NumFiles || batchbytes >= 64 * 1024 * 1024))
 				{
-					// decompress data into RAM and identify it
-					dynamic_buffer data(f->Size);
-					_7zerr = _7z_file_decompress(_7z, &data[0], f->Size);
-					if (_7zerr == _7ZERR_NONE)
-						identify_data((const char*)&temp2[0], &data[0], f->Size);
+					for (size_t reqnum = 0; reqnum < requests.size(); reqnum++)
+						requests[reqnum].buffer = &buffers[reqnum][0];
+					_7z_file_decompress_multiple(_7z, &requests[0], requests.size());
+					for (size_t reqnum = 0; reqnum < requests.size(); reqnum++)
+						if (requests[reqnum].error == _7ZERR_NONE)
+							identify_data(names[reqnum].c_str(), &buffers[reqnum][0], requests[reqnum].length);
+					requests.clear();
+					buffers.clear();
+					names.clear();
+					batchbytes = 0;
 				}
 			}
 
@@ -1833,16 +1855,44 @@ void media_identifier::identify(const char *filename)
 		zip_error ziperr = zip_file_open(filename, &zip);
 		if (ziperr == ZIPERR_NONE && zip != nullptr)
 		{
-			// loop over entries in the ZIP, skipping empty files and directories
-			for (const zip_file_header *entry = zip_file_first_file(zip); entry != nullptr; entry = zip_file_next_file(zip))
-				if (entry->uncompressed_length != 0)
+			// loop over entries in the ZIP, skipping empty files and directories, and
+			// decompress them into RAM in batches so they can be inflated in parallel
+			std::vector<zip_decompress_request> requests;
+			std::vector<dynamic_buffer> buffers;
+			std::vector<std::string> names;
+			UINT64 batchbytes = 0;
+			const zip_file_header *entry = zip_file_first_file(zip);
+			while (entry != nullptr || !requests.empty())
+			{
+				if (entry != nullptr && entry->uncompressed_length != 0)
 				{
-					// decompress data into RAM and identify it
-					dynamic_buffer data(entry->uncompressed_length);
-					ziperr = zip_file_decompress(zip, &data[0], entry->uncompressed_length);
-					if (ziperr == ZIPERR_NONE)
-						identify_data(entry->filename, &data[0], entry->uncompressed_length);
+					zip_decompress_request request;
+					request.header = *entry;
+					request.index = zip->cd_index;
+					request.length = entry->uncompressed_length;
+					requests.push_back(request);
+					buffers.emplace_back(entry->uncompressed_length);
+					names.emplace_back(entry->filename);
+					batchbytes += entry->uncompressed_length;
 				}
+				if (entry != nullptr)
+					entry = zip_file_next_file(zip);
+
+				// identify the batch once it is large enough or the directory is exhausted
+				if (!requests.empty() && (entry == nullptr || batchbytes >= 64 * 1024 * 1024))
+				{
+					for (size_t reqnum = 0; reqnum < requests.size(); reqnum++)
+						requests[reqnum].buffer = &buffers[reqnum][0];
+					zip_file_decompress_multiple(zip, &requests[0], requests.size());
+					for (size_t reqnum = 0; reqnum < requests.size(); reqnum++)
+						if (requests[reqnum].error == ZIPERR_NONE)
+							identify_data(names[reqnum].c_str(), &buffers[reqnum][0], requests[reqnum].length);
+					requests.clear();
+					buffers.clear();
+					names.clear();
+					batchbytes = 0;
+				}
+			}
 
 			// close up
 			zip_file_close(zip);
@@ -127,6 +127,11 @@ void device_gfx_interface::decode_gfx(const gfx_decode_entry *gfxdecodeinfo)
 	std::vector<UINT32> extxoffs(0);
 	std::vector<UINT32> extyoffs(0);
 
+	// if we're pre-decoding, create a work queue to spread the load
+	osd_work_queue *queue = nullptr;
+	if (device().machine().options().gfx_predecode())
+		queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// loop over all elements
 	for (int curgfx = 0; curgfx < MAX_GFX_ELEMENTS && gfxdecodeinfo[curgfx].gfxlayout != nullptr; curgfx++)
 	{
@@ -277,12 +282,63 @@ void device_gfx_interface::decode_gfx(const gfx_decode_entry *gfxdecodeinfo)
 
 		// allocate the graphics
 		m_gfx[curgfx] = std::make_unique<gfx_element>(*m_palette, glcopy, (region_base != nullptr) ? region_base + gfx.start : nullptr, xormask, gfx.total_color_codes, gfx.color_codes_start);
+
+		// pre-decode ROM-based graphics if requested; RAM-based graphics change too often to bother
+		if (queue != nullptr && region_base != nullptr && !GFXENTRY_ISRAM(gfx.flags) && glcopy.planeoffset[0] != GFX_RAW)
+			predecode_gfx(curgfx, queue, region_base, region_length / 8);
 	}
 
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
 	m_decoded = true;
 }
 
 
+//-------------------------------------------------
+//  predecode_gfx - fully decode a gfx element,
+//  loading the results from the graphics cache
+//  if they are available there
+//-------------------------------------------------
+
+void device_gfx_interface::predecode_gfx(int index, osd_work_queue *queue, const UINT8 *srcbase, UINT32 srcbytes)
+{
+	gfx_element &gfx = *m_gfx[index];
+	running_machine &machine = device().machine();
+
+	// the cache is keyed on the contents of the whole source region, which
+	// covers decryption and other driver-applied modifications
+	UINT32 srccrc = crc32_creator::simple(srcbase, srcbytes);
+
+	// build a filename from the device tag and index
+	std::string name(device().tag());
+	if (!name.empty() && name[0] == ':')
+		name.erase(0, 1);
+	for (auto &c : name)
+		if (c == ':')
+			c = '_';
+	strcatprintf(name, "_%d", index);
+
+	// try loading from the cache first
+	{
+		emu_file file(machine.options().gfxcache_directory(), OPEN_FLAG_READ);
+		if (file.open(machine.basename(), PATH_SEPARATOR, name.c_str(), ".gfx") == FILERR_NONE && gfx.load_decoded(file, srccrc))
+		{
+			osd_printf_verbose("Loaded decoded graphics for %s gfx %d from cache\n", device().tag(), index);
+			return;
+		}
+	}
+
+	// decode everything now and write it to the cache for next time
+	gfx.decode_all(queue);
+	emu_file file(machine.options().gfxcache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(machine.basename(), PATH_SEPARATOR, name.c_str(), ".gfx") == FILERR_NONE && !gfx.save_decoded(file, srccrc))
+	{
+		file.remove_on_close();
+		osd_printf_warning("Unable to write decoded graphics cache for %s gfx %d\n", device().tag(), index);
+	}
+}
+
+
 //-------------------------------------------------
 //  interface_validity_check - validate graphics
 //  decoding configuration
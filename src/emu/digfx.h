@@ -215,6 +215,9 @@ protected:
 	virtual void interface_post_start() override;
 
 private:
+	// internal helpers
+	void predecode_gfx(int index, osd_work_queue *queue, const UINT8 *srcbase, UINT32 srcbytes);
+
 	palette_device *            m_palette;                  // pointer to the palette device
 	std::unique_ptr<gfx_element>  m_gfx[MAX_GFX_ELEMENTS];    // array of pointers to graphic sets
 
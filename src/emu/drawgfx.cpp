@@ -20,6 +20,21 @@ UINT8 no_priority_size_is_wrong[2 * (sizeof(NO_PRIORITY) == 3) - 1];
 
 bitmap_ind8 drawgfx_dummy_priority_bitmap;
 
+// decoded graphics cache file format
+static const char GFX_CACHE_MAGIC[8] = { 'M','A','M','E','G','F','X', 0 };
+static const UINT32 GFX_CACHE_VERSION = 1;
+
+struct gfx_cache_header
+{
+	char        magic[8];               // GFX_CACHE_MAGIC
+	UINT32      version;                // GFX_CACHE_VERSION
+	UINT32      srccrc;                 // CRC of the source data the cache was built from
+	UINT32      layoutcrc;              // CRC of the layout used to decode the source data
+	UINT32      elements;               // number of decoded elements
+	UINT32      charmodulo;             // bytes per decoded element
+	UINT32      penusage;               // number of pen usage entries following the pixel data
+};
+
 
 
 /***************************************************************************
@@ -376,6 +391,155 @@ void gfx_element::decode(UINT32 code)
 }
 
 
+//-------------------------------------------------
+//  decode_all - decode every dirty element,
+//  spreading the work across a work queue
+//-------------------------------------------------
+
+void gfx_element::decode_all(osd_work_queue *queue)
+{
+	// build a list of ranges to decode
+	std::vector<decode_range> ranges;
+	for (UINT32 start = 0; start < m_total_elements; start += DECODE_RANGE_ELEMENTS)
+	{
+		decode_range range;
+		range.gfx = this;
+		range.start = start;
+		range.count = MIN(m_total_elements - start, DECODE_RANGE_ELEMENTS);
+		ranges.push_back(range);
+	}
+	if (ranges.empty())
+		return;
+
+	// each element decodes to a distinct area, so the ranges can run in parallel
+	if (queue != nullptr && ranges.size() > 1)
+	{
+		osd_work_item_queue_multiple(queue, decode_range_callback, ranges.size(), &ranges[0], sizeof(ranges[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+	}
+	else
+	{
+		for (auto &range : ranges)
+			decode_range_callback(&range, 0);
+	}
+}
+
+
+//-------------------------------------------------
+//  decode_range_callback - decode a range of
+//  dirty elements on a worker thread
+//-------------------------------------------------
+
+void *gfx_element::decode_range_callback(void *param, int threadid)
+{
+	decode_range &range = *reinterpret_cast<decode_range *>(param);
+	for (UINT32 code = range.start; code < range.start + range.count; code++)
+		if (range.gfx->m_dirty[code])
+			range.gfx->decode(code);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  layout_crc - compute a CRC of the layout
+//  parameters that affect decoded data
+//-------------------------------------------------
+
+UINT32 gfx_element::layout_crc() const
+{
+	crc32_creator crc;
+	UINT32 params[] = { m_origwidth, m_origheight, m_total_elements, m_line_modulo, m_char_modulo, m_layout_planes, m_layout_xormask, m_layout_charincrement };
+	crc.append(params, sizeof(params));
+	if (!m_layout_planeoffset.empty())
+		crc.append(&m_layout_planeoffset[0], m_layout_planeoffset.size() * sizeof(m_layout_planeoffset[0]));
+	if (!m_layout_xoffset.empty())
+		crc.append(&m_layout_xoffset[0], m_layout_xoffset.size() * sizeof(m_layout_xoffset[0]));
+	if (!m_layout_yoffset.empty())
+		crc.append(&m_layout_yoffset[0], m_layout_yoffset.size() * sizeof(m_layout_yoffset[0]));
+	return crc.finish();
+}
+
+
+//-------------------------------------------------
+//  load_decoded - load previously decoded data
+//  from a cache file; returns false if the file
+//  doesn't match the current source and layout
+//-------------------------------------------------
+
+bool gfx_element::load_decoded(emu_file &file, UINT32 srccrc)
+{
+	// raw layouts are never decoded
+	if (m_layout_is_raw || m_total_elements == 0)
+		return false;
+
+	// read and validate the header
+	gfx_cache_header header;
+	if (file.read(&header, sizeof(header)) != sizeof(header))
+		return false;
+	if (memcmp(header.magic, GFX_CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != GFX_CACHE_VERSION)
+		return false;
+	if (header.srccrc != srccrc || header.layoutcrc != layout_crc())
+		return false;
+	if (header.elements != m_total_elements || header.charmodulo != m_char_modulo || header.penusage != m_pen_usage.size())
+		return false;
+
+	// read the pixel data and pen usage directly into place
+	UINT32 databytes = m_total_elements * m_char_modulo;
+	if (file.read(m_gfxdata, databytes) != databytes)
+		return false;
+	if (!m_pen_usage.empty())
+	{
+		UINT32 usagebytes = m_pen_usage.size() * sizeof(m_pen_usage[0]);
+		if (file.read(&m_pen_usage[0], usagebytes) != usagebytes)
+			return false;
+	}
+
+	// everything is now clean
+	memset(&m_dirty[0], 0, m_total_elements);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save_decoded - write the decoded data out to
+//  a cache file
+//-------------------------------------------------
+
+bool gfx_element::save_decoded(emu_file &file, UINT32 srccrc)
+{
+	// raw layouts are never decoded
+	if (m_layout_is_raw || m_total_elements == 0)
+		return false;
+
+	// make sure everything is decoded first
+	decode_all(nullptr);
+
+	// write the header
+	gfx_cache_header header;
+	memcpy(header.magic, GFX_CACHE_MAGIC, sizeof(header.magic));
+	header.version = GFX_CACHE_VERSION;
+	header.srccrc = srccrc;
+	header.layoutcrc = layout_crc();
+	header.elements = m_total_elements;
+	header.charmodulo = m_char_modulo;
+	header.penusage = m_pen_usage.size();
+	if (file.write(&header, sizeof(header)) != sizeof(header))
+		return false;
+
+	// then the pixel data and pen usage
+	UINT32 databytes = m_total_elements * m_char_modulo;
+	if (file.write(m_gfxdata, databytes) != databytes)
+		return false;
+	if (!m_pen_usage.empty())
+	{
+		UINT32 usagebytes = m_pen_usage.size() * sizeof(m_pen_usage[0]);
+		if (file.write(&m_pen_usage[0], usagebytes) != usagebytes)
+			return false;
+	}
+	return true;
+}
+
+
 
 /***************************************************************************
     DRAWGFX IMPLEMENTATIONS
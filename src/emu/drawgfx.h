@@ -199,6 +199,11 @@ public:
 		return m_pen_usage[code];
 	}
 
+	// bulk decoding and decode caching
+	void decode_all(osd_work_queue *queue);
+	bool load_decoded(emu_file &file, UINT32 srccrc);
+	bool save_decoded(emu_file &file, UINT32 srccrc);
+
 	// ----- core graphics drawing -----
 
 	// specific drawgfx implementations for each transparency type
@@ -265,8 +270,19 @@ public:
 	void alphastore(bitmap_rgb32 &dest, const rectangle &cliprect,UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty,int fixedalpha, UINT8 *alphatable);
 	void alphatable(bitmap_rgb32 &dest, const rectangle &cliprect, UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty, int fixedalpha ,UINT8 *alphatable);
 private:
+	// range of elements decoded by a single work item
+	struct decode_range
+	{
+		gfx_element *   gfx;
+		UINT32          start;
+		UINT32          count;
+	};
+	static const UINT32 DECODE_RANGE_ELEMENTS = 256;
+
 	// internal helpers
 	void decode(UINT32 code);
+	static void *decode_range_callback(void *param, int threadid);
+	UINT32 layout_crc() const;
 
 	// internal state
 	palette_device  *m_palette;             // palette used for drawing
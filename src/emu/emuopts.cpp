@@ -58,6 +58,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DIFF_DIRECTORY,                             "diff",      OPTION_STRING,     "directory to save hard drive image difference files" },
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  OPTION_STRING,     "directory to save debugger comments" },
 	{ OPTION_HISCORE_DIRECTORY,                          "hi",        OPTION_STRING,     "directory to save high score files" },
+	{ OPTION_GFXCACHE_DIRECTORY,                         "gfxcache",  OPTION_STRING,     "directory to save pre-decoded graphics caches" },
 
 	// state/playback options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
@@ -71,6 +72,8 @@ const options_entry emu_options::s_option_entries[] =
 
 	{ OPTION_MNGWRITE,                                   nullptr,        OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   nullptr,        OPTION_STRING,     "optional filename to write an AVI movie of the current session" },
+	{ OPTION_MNGCOMPRESSION "(0-9)",                     "6",         OPTION_INTEGER,    "zlib level for MNG movie frames; 0 stores, 1 is fastest, 9 is smallest" },
+	{ OPTION_MOVIEQUEUE "(0-64)",                        "8",         OPTION_INTEGER,    "number of movie frames to buffer for the encoder thread; 0 records synchronously" },
 #ifdef MAME_DEBUG
 	{ OPTION_DUMMYWRITE,                                 "0",         OPTION_BOOLEAN,    "indicates if a snapshot should be created if each frame" },
 #endif
@@ -93,6 +96,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
 	{ OPTION_FASTSTART ";fs(0-2)",                       "1",         OPTION_INTEGER,    "fast forward machine startup. 0=Off 1=On 2=Extended." },
 	{ OPTION_FASTSTART_SKIP ";fss",                      "1",         OPTION_BOOLEAN,    "do not render frames during fast start." },
+	{ OPTION_GFX_PREDECODE,                              "0",         OPTION_BOOLEAN,    "decode all graphics at startup using worker threads, caching the results" },
+	{ OPTION_CHD_CACHE "(1-1024)",                       "16",        OPTION_INTEGER,    "number of decompressed hunks to cache for each CHD" },
+	{ OPTION_CHD_READAHEAD "(0-64)",                     "4",         OPTION_INTEGER,    "number of hunks to decompress ahead on worker threads when a CHD is read sequentially" },
 
 	// rotation options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE ROTATION OPTIONS" },
@@ -134,6 +140,10 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_RESAMPLE_QUALITY "(0-2)",                   "0",         OPTION_INTEGER,    "stream resampling quality (0 = fastest, 1 = linear, 2 = windowed sinc)" },
+	{ OPTION_SOUND_PARALLEL,                             "0",         OPTION_BOOLEAN,    "generate independent sound streams concurrently on worker threads" },
+	{ OPTION_DISCRETE_AUTO_TASKS,                        "0",         OPTION_BOOLEAN,    "split discrete sound netlists without explicit tasks into parallel tasks" },
+	{ OPTION_DYNAMIC_RATE_CONTROL "(0.0-0.05)",          "0.0",       OPTION_FLOAT,      "maximum sound rate adjustment used to keep the OSD sound buffer half full (0 = off)" },
 
 	// input options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
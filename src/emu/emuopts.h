@@ -70,6 +70,7 @@ enum
 #define OPTION_DIFF_DIRECTORY       "diff_directory"
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
 #define OPTION_HISCORE_DIRECTORY    "hiscore_directory"
+#define OPTION_GFXCACHE_DIRECTORY   "gfxcache_directory"
 
 // core state/playback options
 #define OPTION_STATE                "state"
@@ -80,6 +81,8 @@ enum
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
+#define OPTION_MNGCOMPRESSION       "mngcompression"
+#define OPTION_MOVIEQUEUE           "moviequeue"
 #ifdef MAME_DEBUG
 #define OPTION_DUMMYWRITE           "dummywrite"
 #endif
@@ -101,6 +104,9 @@ enum
 #define OPTION_REFRESHSPEED         "refreshspeed"
 #define OPTION_FASTSTART            "faststart"
 #define OPTION_FASTSTART_SKIP       "faststart_skip"
+#define OPTION_GFX_PREDECODE        "gfx_predecode"
+#define OPTION_CHD_CACHE            "chd_cache"
+#define OPTION_CHD_READAHEAD        "chd_readahead"
 
 // core rotation options
 #define OPTION_ROTATE               "rotate"
@@ -137,6 +143,10 @@ enum
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
 #define OPTION_VOLUME               "volume"
+#define OPTION_RESAMPLE_QUALITY     "resample_quality"
+#define OPTION_SOUND_PARALLEL       "sound_parallel"
+#define OPTION_DISCRETE_AUTO_TASKS  "discrete_auto_tasks"
+#define OPTION_DYNAMIC_RATE_CONTROL "dynamic_rate_control"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -264,6 +274,7 @@ public:
 	const char *diff_directory() const { return value(OPTION_DIFF_DIRECTORY); }
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
 	const char *hiscore_directory() const { return value(OPTION_HISCORE_DIRECTORY); }
+	const char *gfxcache_directory() const { return value(OPTION_GFXCACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
@@ -274,6 +285,8 @@ public:
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
+	int mng_compression() const { return int_value(OPTION_MNGCOMPRESSION); }
+	int movie_queue() const { return int_value(OPTION_MOVIEQUEUE); }
 #ifdef MAME_DEBUG
 	bool dummy_write() const { return bool_value(OPTION_DUMMYWRITE); }
 #endif
@@ -295,6 +308,9 @@ public:
 	bool refresh_speed() const { return m_refresh_speed; }
 	int fast_start() const { return int_value(OPTION_FASTSTART); }
 	bool fast_start_skip() const { return bool_value(OPTION_FASTSTART_SKIP); }
+	bool gfx_predecode() const { return bool_value(OPTION_GFX_PREDECODE); }
+	int chd_cache() const { return int_value(OPTION_CHD_CACHE); }
+	int chd_readahead() const { return int_value(OPTION_CHD_READAHEAD); }
 
 	// core rotation options
 	bool rotate() const { return bool_value(OPTION_ROTATE); }
@@ -331,6 +347,10 @@ public:
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	int resample_quality() const { return int_value(OPTION_RESAMPLE_QUALITY); }
+	bool sound_parallel() const { return bool_value(OPTION_SOUND_PARALLEL); }
+	bool discrete_auto_tasks() const { return bool_value(OPTION_DISCRETE_AUTO_TASKS); }
+	float dynamic_rate_control() const { return float_value(OPTION_DYNAMIC_RATE_CONTROL); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -260,6 +260,23 @@ int rom_load_manager::set_disk_handle(const char *region, const char *fullpath)
 	return err;
 }
 
+
+/*-------------------------------------------------
+    exit - report how the hunk caches of the
+    open disks performed
+-------------------------------------------------*/
+
+void rom_load_manager::exit()
+{
+	for (auto &curdisk : m_chd_list)
+	{
+		/* the cache is set up on the original; a diff only holds the writes */
+		chd_file &chd = curdisk->orig_chd();
+		osd_printf_verbose("Disk \"%s\": %" I64FMT "d hunk cache hits (%" I64FMT "d from read ahead), %" I64FMT "d misses\n",
+				curdisk->region(), chd.cache_hits(), chd.readahead_hits(), chd.cache_misses());
+	}
+}
+
 /*-------------------------------------------------
     determine_bios_rom - determine system_bios
     from SystemBios structure and OPTION_BIOS
@@ -1175,6 +1192,9 @@ void rom_load_manager::process_disk_entries(const char *regiontag, const rom_ent
 				continue;
 			}
 
+			/* size the hunk cache; a diff file reads through to this one */
+			chd->orig_chd().set_cache_size(machine().options().chd_cache(), machine().options().chd_readahead());
+
 			/* get the header and extract the SHA1 */
 			hash_collection acthashes;
 			acthashes.add_sha1(chd->orig_chd().sha1());
@@ -1481,4 +1501,7 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 
 	/* display the results and exit */
 	display_rom_load_results(FALSE);
+
+	/* report disk cache statistics when the machine exits */
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(rom_load_manager::exit), this));
 }
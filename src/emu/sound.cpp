@@ -252,6 +252,9 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	if (input.m_source != nullptr)
 		input.m_source->m_dependents++;
 
+	// the stream graph has changed
+	m_device.machine().sound().m_levels_dirty = true;
+
 	// update sample rates now that we know the input
 	recompute_sample_rate_data();
 }
@@ -283,6 +286,11 @@ void sound_stream::update()
 		update_sampindex -= m_sample_rate;
 	}
 
+	// if we're already there, there's nothing to write; parallel updates rely on
+	// streams that are already up to date being left untouched
+	if (update_sampindex == m_output_sampindex)
+		return;
+
 	// generate samples to get us up to the appropriate time
 	g_profiler.start(PROFILER_SOUND);
 	assert(m_output_sampindex - m_output_base_sampindex >= 0);
@@ -503,6 +511,10 @@ void sound_stream::recompute_sample_rate_data()
 			else if (input.m_source->m_stream->m_sample_rate == m_sample_rate)
 				latency = 0;
 
+			// filtering resamplers need to look a few source samples further ahead
+			if (input.m_source->m_stream->m_sample_rate != m_sample_rate)
+				latency += resample_lookahead(input.m_source->m_stream->m_sample_rate) * new_attosecs_per_sample;
+
 			// we generally don't want to tweak the latency, so we just keep the greatest
 			// one we've computed thus far
 			input.m_latency_attoseconds = MAX(input.m_latency_attoseconds, latency);
@@ -683,8 +695,9 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 	UINT32 basefrac = (basetime - basesample * input_stream.m_attoseconds_per_sample) / ((input_stream.m_attoseconds_per_sample + FRAC_ONE - 1) >> FRAC_BITS);
 	assert(basefrac < FRAC_ONE);
 
-	// compute the stepping fraction
-	UINT32 step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
+	// fetch the stepping fraction and filter for this pair of rates
+	update_resample_state(input);
+	UINT32 step = input.m_resample_step;
 
 	// if we have equal sample rates, we just need to copy
 	if (step == FRAC_ONE)
@@ -697,6 +710,47 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 		}
 	}
 
+	// windowed sinc: run the polyphase filter centered on each output position
+	else if (input.m_resample_taps != 0)
+	{
+		int taps = input.m_resample_taps;
+		source -= taps / 2 - 1;
+		assert(source >= &output.m_buffer[0]);
+		while (numsamples--)
+		{
+			// pick the filter phase for this fractional position
+			const INT32 *kernel = &input.m_resample_kernel[(basefrac >> (FRAC_BITS - RESAMPLE_PHASE_BITS)) * taps];
+
+			// compute the sample
+			INT64 sample = 0;
+			for (int tap = 0; tap < taps; tap++)
+				sample += (INT64) source[tap] * kernel[tap];
+			sample >>= RESAMPLE_KERNEL_BITS;
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
+		}
+	}
+
+	// input is undersampled and we want linear interpolation
+	else if (step < FRAC_ONE && m_device.machine().sound().resample_quality() >= 1)
+	{
+		while (numsamples--)
+		{
+			// blend between the two samples around us
+			INT64 sample = source[0] + (((INT64) (source[1] - source[0]) * (basefrac >> (FRAC_BITS - 12))) >> 12);
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
+		}
+	}
+
 	// input is undersampled: point sample except where our sample period covers a boundary
 	else if (step < FRAC_ONE)
 	{
@@ -763,6 +817,91 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 }
 
 
+//-------------------------------------------------
+//  resample_lookahead - return the number of
+//  extra source samples the resampler needs
+//  beyond the current position for a source
+//  running at the given rate
+//-------------------------------------------------
+
+int sound_stream::resample_lookahead(UINT32 source_rate) const
+{
+	// only the windowed sinc filter looks ahead, and only up to a 4:1 reduction
+	if (m_device.machine().sound().resample_quality() < 2 || source_rate > 4 * m_sample_rate)
+		return 0;
+
+	// widen the filter as the cutoff drops so the transition band stays the same
+	int taps = RESAMPLE_SINC_TAPS;
+	if (source_rate > m_sample_rate)
+		taps = (RESAMPLE_SINC_TAPS * UINT64(source_rate) / m_sample_rate + 1) & ~1;
+	return MIN(taps, RESAMPLE_MAX_TAPS) / 2;
+}
+
+
+//-------------------------------------------------
+//  update_resample_state - rebuild the cached
+//  stepping and filter kernel for an input if
+//  either sample rate has changed
+//-------------------------------------------------
+
+void sound_stream::update_resample_state(stream_input &input)
+{
+	sound_stream &input_stream = *input.m_source->m_stream;
+	if (input.m_resample_source_rate == input_stream.m_sample_rate && input.m_resample_rate == m_sample_rate)
+		return;
+
+	// compute the stepping fraction
+	input.m_resample_source_rate = input_stream.m_sample_rate;
+	input.m_resample_rate = m_sample_rate;
+	input.m_resample_step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
+	input.m_resample_taps = 0;
+	input.m_resample_kernel.clear();
+	if (input.m_resample_step == FRAC_ONE)
+		return;
+
+	// the filter needs half its taps ahead of the current position; make sure the
+	// latency we computed covers that, since it only grows when our own rate changes
+	int half = resample_lookahead(input_stream.m_sample_rate);
+	if (half == 0)
+		return;
+	attoseconds_t source_period = input_stream.m_attoseconds_per_sample;
+	attoseconds_t base_latency = MAX(source_period, m_attoseconds_per_sample);
+	if (input_stream.m_sample_rate < m_sample_rate)
+		base_latency += source_period;
+	if (input.m_latency_attoseconds - base_latency < half * source_period)
+		return;
+
+	// and half of them behind it, which must still be in the source's output buffer
+	if (half >= input_stream.m_max_samples_per_update - input.m_latency_attoseconds / source_period - 1)
+		return;
+
+	// build a Blackman-windowed sinc for each phase, with the cutoff at the lower
+	// of the two Nyquist frequencies
+	int taps = half * 2;
+	double cutoff = MIN(1.0, double(m_sample_rate) / double(input_stream.m_sample_rate));
+	input.m_resample_taps = taps;
+	input.m_resample_kernel.resize(RESAMPLE_PHASES * taps);
+	for (int phase = 0; phase < RESAMPLE_PHASES; phase++)
+	{
+		INT32 *kernel = &input.m_resample_kernel[phase * taps];
+		double coeffs[RESAMPLE_MAX_TAPS];
+		double sum = 0;
+		for (int tap = 0; tap < taps; tap++)
+		{
+			double x = double(tap - (half - 1)) - double(phase) / RESAMPLE_PHASES;
+			double window = 0.42 + 0.5 * cos(M_PI * x / half) + 0.08 * cos(2.0 * M_PI * x / half);
+			double sinc = (x == 0) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+			coeffs[tap] = sinc * window;
+			sum += coeffs[tap];
+		}
+
+		// normalize each phase to unity gain so DC passes unchanged
+		for (int tap = 0; tap < taps; tap++)
+			kernel[tap] = INT32(floor(coeffs[tap] * (1 << RESAMPLE_KERNEL_BITS) / sum + 0.5));
+	}
+}
+
+
 
 //**************************************************************************
 //  STREAM INPUT
@@ -775,6 +914,10 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 sound_stream::stream_input::stream_input()
 	: m_source(nullptr),
 		m_latency_attoseconds(0),
+		m_resample_source_rate(0),
+		m_resample_rate(0),
+		m_resample_step(FRAC_ONE),
+		m_resample_taps(0),
 		m_gain(0x100),
 		m_user_gain(0x100)
 {
@@ -817,9 +960,15 @@ sound_manager::sound_manager(running_machine &machine)
 		m_muted(0),
 		m_attenuation(0),
 		m_nosound_mode(machine.osd().no_sound()),
+		m_resample_quality(machine.options().resample_quality()),
+		m_rate_control(machine.options().dynamic_rate_control()),
+		m_rate_fill(0.5),
+		m_rate_carry(0),
 		m_wavfile(nullptr),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds()),
-		m_last_update(attotime::zero)
+		m_last_update(attotime::zero),
+		m_work_queue(nullptr),
+		m_levels_dirty(true)
 {
 	// get filename for WAV file or AVI file if specified
 	const char *wavfile = machine.options().wav_write();
@@ -839,6 +988,10 @@ sound_manager::sound_manager(running_machine &machine)
 	if (wavfile[0] != 0 && &machine.system() != &GAME_NAME(___empty))
 		m_wavfile = wav_open(wavfile, machine.sample_rate(), 2);
 
+	// allocate a work queue if we're generating streams in parallel
+	if (machine.options().sound_parallel())
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// register callbacks
 	machine.configuration().config_register("mixer", config_saveload_delegate(FUNC(sound_manager::config_load), this), config_saveload_delegate(FUNC(sound_manager::config_save), this));
 	machine.add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(FUNC(sound_manager::pause), this));
@@ -867,6 +1020,10 @@ sound_manager::~sound_manager()
 	if (m_wavfile != nullptr)
 		wav_close(m_wavfile);
 	m_wavfile = nullptr;
+
+	// free the work queue
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
 }
 
 
@@ -876,6 +1033,7 @@ sound_manager::~sound_manager()
 
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback)
 {
+	m_levels_dirty = true;
 	return &m_stream_list.append(*global_alloc(sound_stream(device, inputs, outputs, sample_rate, callback)));
 }
 
@@ -1038,6 +1196,11 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// bring independent streams up to date on worker threads first; the profiler
+	// isn't thread safe, so stay serial while it's running
+	if (m_work_queue != nullptr && !g_profiler.enabled())
+		update_streams_parallel();
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	speaker_device_iterator iter(machine().root_device());
@@ -1046,6 +1209,20 @@ void sound_manager::update(void *ptr, int param)
 
 	// now downmix the final result
 	UINT32 finalmix_step = machine().video().speed_factor();
+
+	// with dynamic rate control, nudge the step so the OSD buffer stays half full:
+	// a smaller step produces more output samples and fills it up
+	if (m_rate_control != 0)
+	{
+		float fill = machine().osd().audio_buffer_fill();
+		if (fill >= 0)
+		{
+			m_rate_fill += (fill - m_rate_fill) * 0.125;
+			double step = finalmix_step * (1.0 - m_rate_control * (1.0 - 2.0 * m_rate_fill)) + m_rate_carry;
+			finalmix_step = UINT32(step);
+			m_rate_carry = step - finalmix_step;
+		}
+	}
 	UINT32 finalmix_offset = 0;
 	INT16 *finalmix = &m_finalmix[0];
 	int sample;
@@ -1103,3 +1280,101 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.stop();
 }
+
+
+//-------------------------------------------------
+//  stream_level - return the dependency depth of
+//  a stream, or -1 if it must be updated on the
+//  emulation thread
+//-------------------------------------------------
+
+int sound_manager::stream_level(sound_stream &stream, std::unordered_map<sound_stream *, int> &levels)
+{
+	// return the cached result; a stream still being visited is part of a loop
+	auto found = levels.find(&stream);
+	if (found != levels.end())
+		return found->second;
+	levels[&stream] = -1;
+
+	// synchronous streams are updated from their timer, so leave them alone
+	if (stream.m_synchronous)
+		return -1;
+
+	// we sit one level above the deepest of our inputs
+	int level = 0;
+	for (auto &input : stream.m_input)
+		if (input.m_source != nullptr)
+		{
+			int inputlevel = stream_level(*input.m_source->m_stream, levels);
+			if (inputlevel < 0)
+				return -1;
+			level = MAX(level, inputlevel + 1);
+		}
+
+	levels[&stream] = level;
+	return level;
+}
+
+
+//-------------------------------------------------
+//  build_stream_levels - group the streams by
+//  dependency depth, so that all the streams in
+//  one level only depend on earlier levels
+//-------------------------------------------------
+
+void sound_manager::build_stream_levels()
+{
+	std::unordered_map<sound_stream *, int> levels;
+
+	m_stream_levels.clear();
+	for (sound_stream *stream = m_stream_list.first(); stream != nullptr; stream = stream->next())
+	{
+		int level = stream_level(*stream, levels);
+		if (level < 0)
+			continue;
+		if (level >= m_stream_levels.size())
+			m_stream_levels.resize(level + 1);
+		m_stream_levels[level].push_back(stream);
+	}
+	m_levels_dirty = false;
+
+	VPRINTF(("build_stream_levels: %d levels\n", int(m_stream_levels.size())));
+}
+
+
+//-------------------------------------------------
+//  update_stream_callback - work item callback
+//  that brings one stream up to date
+//-------------------------------------------------
+
+void *sound_manager::update_stream_callback(void *param, int threadid)
+{
+	sound_stream *stream = *(sound_stream **)param;
+	stream->update();
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  update_streams_parallel - update the streams
+//  one dependency level at a time, running the
+//  streams within each level concurrently
+//-------------------------------------------------
+
+void sound_manager::update_streams_parallel()
+{
+	if (m_levels_dirty)
+		build_stream_levels();
+
+	for (auto &level : m_stream_levels)
+	{
+		// not worth handing off a single stream
+		if (level.size() == 1)
+			level[0]->update();
+		else
+		{
+			osd_work_item_queue_multiple(m_work_queue, update_stream_callback, level.size(), &level[0], sizeof(level[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 10);
+		}
+	}
+}
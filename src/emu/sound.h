@@ -84,6 +84,11 @@ class sound_stream
 		stream_output *     m_source;               // pointer to the sound_output for this source
 		std::vector<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
+		UINT32              m_resample_source_rate; // source sample rate the resample state was built for
+		UINT32              m_resample_rate;        // our sample rate the resample state was built for
+		UINT32              m_resample_step;        // stepping fraction, in FRAC_ONE units
+		int                 m_resample_taps;        // filter taps per output sample (0 = no filter)
+		std::vector<INT32>  m_resample_kernel;    // polyphase filter kernel, RESAMPLE_PHASES x taps
 		INT16               m_gain;                 // gain to apply to this input
 		INT16               m_user_gain;            // user-controlled gain to apply to this input
 	};
@@ -93,6 +98,11 @@ class sound_stream
 	static const UINT32 FRAC_BITS               = 22;
 	static const UINT32 FRAC_ONE                = 1 << FRAC_BITS;
 	static const UINT32 FRAC_MASK               = FRAC_ONE - 1;
+	static const int RESAMPLE_PHASE_BITS        = 8;
+	static const int RESAMPLE_PHASES            = 1 << RESAMPLE_PHASE_BITS;
+	static const int RESAMPLE_KERNEL_BITS       = 14;
+	static const int RESAMPLE_SINC_TAPS         = 16;
+	static const int RESAMPLE_MAX_TAPS          = 64;
 
 	// construction/destruction
 	sound_stream(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback);
@@ -136,6 +146,8 @@ private:
 	void postload();
 	void generate_samples(int samples);
 	stream_sample_t *generate_resampled_data(stream_input &input, UINT32 numsamples);
+	void update_resample_state(stream_input &input);
+	int resample_lookahead(UINT32 source_rate) const;
 	void sync_update(void *, INT32);
 
 	// linking information
@@ -202,6 +214,7 @@ public:
 	sound_stream *first_stream() const { return m_stream_list.first(); }
 	attotime last_update() const { return m_last_update; }
 	attoseconds_t update_attoseconds() const { return m_update_attoseconds; }
+	int resample_quality() const { return m_resample_quality; }
 
 	// stream creation
 	sound_stream *stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback = stream_update_delegate());
@@ -226,6 +239,10 @@ private:
 	void config_save(config_type cfg_type, xml_data_node *parentnode);
 
 	void update(void *ptr = nullptr, INT32 param = 0);
+	void build_stream_levels();
+	int stream_level(sound_stream &stream, std::unordered_map<sound_stream *, int> &levels);
+	void update_streams_parallel();
+	static void *update_stream_callback(void *param, int threadid);
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -239,6 +256,10 @@ private:
 	UINT8               m_muted;
 	int                 m_attenuation;
 	int                 m_nosound_mode;
+	int                 m_resample_quality;
+	float               m_rate_control;         // maximum dynamic rate adjustment (0 = off)
+	double              m_rate_fill;            // smoothed OSD buffer fill
+	double              m_rate_carry;           // fractional part of the adjusted mix step
 
 	wav_file *          m_wavfile;
 
@@ -246,6 +267,11 @@ private:
 	simple_list<sound_stream> m_stream_list;    // list of streams
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
 	attotime            m_last_update;          // last update time
+
+	// parallel update data
+	osd_work_queue *    m_work_queue;           // work queue for parallel stream updates
+	bool                m_levels_dirty;         // do we need to rebuild the stream levels?
+	std::vector<std::vector<sound_stream *>> m_stream_levels; // independent streams grouped by dependency depth
 };
 
 
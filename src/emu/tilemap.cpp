@@ -724,12 +724,8 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// flush the dirty state to all tiles as appropriate
 	realize_all_dirty_tiles();
 
-	// iterate over rows and columns
-	logical_index logindex = 0;
-	for (int row = 0; row < m_rows; row++)
-		for (int col = 0; col < m_cols; col++, logindex++)
-			if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
-				tile_update(logindex, col, row);
+	// realize every dirty tile
+	realize_dirty_tiles(0, m_cols, 0, m_rows);
 
 	// mark it all clean
 	m_all_tiles_clean = true;
@@ -738,6 +734,80 @@ g_profiler.stop();
 }
 
 
+//-------------------------------------------------
+//  realize_dirty_tiles - render all dirty tiles
+//  within a range of columns and rows (max values
+//  are exclusive), spreading large batches across
+//  worker threads
+//-------------------------------------------------
+
+void tilemap_t::realize_dirty_tiles(UINT32 mincol, UINT32 maxcol, UINT32 minrow, UINT32 maxrow)
+{
+	// gather the dirty tiles first; this calls back into the driver so it
+	// must happen here on the emulation thread
+	m_realize_list.clear();
+	for (UINT32 row = minrow; row < maxrow; row++)
+	{
+		logical_index logindex = row * m_cols + mincol;
+		for (UINT32 col = mincol; col < maxcol; col++, logindex++)
+			if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
+			{
+				m_realize_list.resize(m_realize_list.size() + 1);
+				tile_fetch(m_realize_list.back(), logindex, col, row);
+			}
+	}
+
+	// nothing to do if everything was clean
+	UINT32 count = m_realize_list.size();
+	if (count == 0)
+		return;
+	m_manager->count_realized(count);
+
+g_profiler.start(PROFILER_TILEMAP_UPDATE);
+
+	// small updates aren't worth the overhead of the work queue
+	osd_work_queue *queue = m_manager->work_queue();
+	if (queue == nullptr || count < 2 * REALIZE_BATCH_TILES)
+	{
+		for (UINT32 index = 0; index < count; index++)
+			tile_render(m_realize_list[index]);
+	}
+
+	// otherwise, split the list into batches; each tile touches a distinct
+	// area of the pixmap and flagsmap, so no locking is required
+	else
+	{
+		m_realize_batches.resize((count + REALIZE_BATCH_TILES - 1) / REALIZE_BATCH_TILES);
+		for (UINT32 batchnum = 0; batchnum < m_realize_batches.size(); batchnum++)
+		{
+			realize_batch &batch = m_realize_batches[batchnum];
+			batch.tilemap = this;
+			batch.start = batchnum * REALIZE_BATCH_TILES;
+			batch.count = MIN(count - batch.start, REALIZE_BATCH_TILES);
+		}
+		osd_work_item_queue_multiple(queue, realize_batch_callback, m_realize_batches.size(), &m_realize_batches[0], sizeof(m_realize_batches[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(queue, osd_ticks_per_second() * 10);
+	}
+
+g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  realize_batch_callback - render a batch of
+//  previously fetched tiles on a worker thread
+//-------------------------------------------------
+
+void *tilemap_t::realize_batch_callback(void *param, int threadid)
+{
+	realize_batch &batch = *reinterpret_cast<realize_batch *>(param);
+	tilemap_t &tmap = *batch.tilemap;
+	for (UINT32 index = batch.start; index < batch.start + batch.count; index++)
+		tmap.tile_render(tmap.m_realize_list[index]);
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  tile_update - update a single dirty tile
 //-------------------------------------------------
@@ -746,22 +816,38 @@ void tilemap_t::tile_update(logical_index logindex, UINT32 col, UINT32 row)
 {
 g_profiler.start(PROFILER_TILEMAP_UPDATE);
 
+	realize_item item;
+	tile_fetch(item, logindex, col, row);
+	tile_render(item);
+	m_manager->count_realized(1);
+
+g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  tile_fetch - call the get info callback for a
+//  single dirty tile and capture the results
+//-------------------------------------------------
+
+void tilemap_t::tile_fetch(realize_item &item, logical_index logindex, UINT32 col, UINT32 row)
+{
 	// call the get info callback for the associated memory index
 	tilemap_memory_index memindex = m_logical_to_memory[logindex];
 	m_tile_get_info(*this, m_tileinfo, memindex);
 
-	// apply the global tilemap flip to the returned flip flags
-	UINT32 flags = m_tileinfo.flags ^ (m_attributes & 0x03);
-
-	// draw the tile, using either direct or transparent
-	UINT32 x0 = m_tilewidth * col;
-	UINT32 y0 = m_tileheight * row;
-	m_tileflags[logindex] = tile_draw(m_tileinfo.pen_data, x0, y0,
-		m_tileinfo.palette_base, m_tileinfo.category, m_tileinfo.group, flags, m_tileinfo.pen_mask);
-
-	// if mask data is specified, apply it
-	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && m_tileinfo.mask_data != nullptr)
-		m_tileflags[logindex] = tile_apply_bitmask(m_tileinfo.mask_data, x0, y0, m_tileinfo.category, flags);
+	// capture everything needed to render the tile, applying the global
+	// tilemap flip to the returned flip flags
+	item.logindex = logindex;
+	item.x0 = m_tilewidth * col;
+	item.y0 = m_tileheight * row;
+	item.pen_data = m_tileinfo.pen_data;
+	item.mask_data = m_tileinfo.mask_data;
+	item.palette_base = m_tileinfo.palette_base;
+	item.category = m_tileinfo.category;
+	item.group = m_tileinfo.group;
+	item.flags = m_tileinfo.flags ^ (m_attributes & 0x03);
+	item.pen_mask = m_tileinfo.pen_mask;
 
 	// track which gfx have been used for this tilemap
 	if (m_tileinfo.gfxnum != 0xff && (m_gfx_used & (1 << m_tileinfo.gfxnum)) == 0)
@@ -769,8 +855,25 @@ g_profiler.start(PROFILER_TILEMAP_UPDATE);
 		m_gfx_used |= 1 << m_tileinfo.gfxnum;
 		m_gfx_dirtyseq[m_tileinfo.gfxnum] = m_tileinfo.decoder->gfx(m_tileinfo.gfxnum)->dirtyseq();
 	}
+}
 
-g_profiler.stop();
+
+//-------------------------------------------------
+//  tile_render - draw a previously fetched tile
+//  and update its summary flags; safe to call
+//  from worker threads
+//-------------------------------------------------
+
+void tilemap_t::tile_render(const realize_item &item)
+{
+	// draw the tile, using either direct or transparent
+	UINT8 tileflags = tile_draw(item.pen_data, item.x0, item.y0,
+		item.palette_base, item.category, item.group, item.flags, item.pen_mask);
+
+	// if mask data is specified, apply it
+	if ((item.flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && item.mask_data != nullptr)
+		tileflags = tile_apply_bitmask(item.mask_data, item.x0, item.y0, item.category, item.flags);
+	m_tileflags[item.logindex] = tileflags;
 }
 
 
@@ -1146,6 +1249,10 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 	int mincol = x1 / m_tilewidth;
 	int maxcol = (x2 + m_tilewidth - 1) / m_tilewidth;
 
+	// realize all the dirty tiles in this instance up front, so they can
+	// be rendered in parallel
+	realize_dirty_tiles(mincol, maxcol, y1 / m_tileheight, (y2 + m_tileheight - 1) / m_tileheight);
+
 	// set up row counter
 	int y = y1;
 	int nexty = m_tileheight * (y1 / m_tileheight) + m_tileheight;
@@ -1486,8 +1593,16 @@ void tilemap_t::draw_debug(screen_device &screen, bitmap_rgb32 &dest, UINT32 scr
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
-{
+		m_instance(0),
+		m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ)),
+		m_realize_frame(0),
+		m_realize_frame_count(0),
+		m_realize_peak(0),
+		m_realize_frames(0),
+		m_realize_total(0)
+{
+	// request a callback upon exiting
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(tilemap_manager::exit), this));
 }
 
 
@@ -1511,6 +1626,56 @@ tilemap_manager::~tilemap_manager()
 				break;
 			}
 	}
+
+	// free the work queue
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
+}
+
+
+//-------------------------------------------------
+//  exit - report realization statistics
+//-------------------------------------------------
+
+void tilemap_manager::exit()
+{
+	// fold in the final frame
+	if (m_realize_frame_count != 0)
+	{
+		m_realize_frames++;
+		m_realize_total += m_realize_frame_count;
+		m_realize_peak = MAX(m_realize_peak, m_realize_frame_count);
+		m_realize_frame_count = 0;
+	}
+
+	if (m_realize_frames != 0)
+		osd_printf_verbose("Tilemaps: %d tiles realized over %d frames (average %d, peak %d per frame)\n",
+			(int)m_realize_total, (int)m_realize_frames, (int)(m_realize_total / m_realize_frames), m_realize_peak);
+}
+
+
+//-------------------------------------------------
+//  count_realized - accumulate the number of
+//  tiles realized during the current frame
+//-------------------------------------------------
+
+void tilemap_manager::count_realized(UINT32 count)
+{
+	// fold the previous frame's count into the totals when the frame changes
+	screen_device *screen = machine().first_screen();
+	UINT64 frame = (screen != nullptr) ? screen->frame_number() : 0;
+	if (frame != m_realize_frame)
+	{
+		if (m_realize_frame_count != 0)
+		{
+			m_realize_frames++;
+			m_realize_total += m_realize_frame_count;
+			m_realize_peak = MAX(m_realize_peak, m_realize_frame_count);
+		}
+		m_realize_frame = frame;
+		m_realize_frame_count = 0;
+	}
+	m_realize_frame_count += count;
 }
 
 
@@ -486,6 +486,9 @@ class tilemap_t
 	// maximum index in each array
 	static const int MAX_PEN_TO_FLAGS = 256;
 
+	// number of tiles rendered by each worker thread work item
+	static const int REALIZE_BATCH_TILES = 32;
+
 protected:
 	// tilemap_manager controlls our allocations
 	tilemap_t();
@@ -587,6 +590,29 @@ private:
 		UINT8               alpha;
 	};
 
+	// captured tile information for deferred rendering
+	struct realize_item
+	{
+		logical_index       logindex;
+		UINT32              x0;
+		UINT32              y0;
+		const UINT8 *       pen_data;
+		const UINT8 *       mask_data;
+		pen_t               palette_base;
+		UINT8               category;
+		UINT8               group;
+		UINT8               flags;
+		UINT8               pen_mask;
+	};
+
+	// range of realize_items handed to a worker thread
+	struct realize_batch
+	{
+		tilemap_t *         tilemap;
+		UINT32              start;
+		UINT32              count;
+	};
+
 	// inline helpers
 	INT32 effective_rowscroll(int index, UINT32 screen_width);
 	INT32 effective_colscroll(int index, UINT32 screen_height);
@@ -607,10 +633,14 @@ private:
 	void mappings_create();
 	void mappings_update();
 	void realize_all_dirty_tiles();
+	void realize_dirty_tiles(UINT32 mincol, UINT32 maxcol, UINT32 minrow, UINT32 maxrow);
+	static void *realize_batch_callback(void *param, int threadid);
 
 	// internal drawing
 	void pixmap_update();
 	void tile_update(logical_index logindex, UINT32 col, UINT32 row);
+	void tile_fetch(realize_item &item, logical_index logindex, UINT32 col, UINT32 row);
+	void tile_render(const realize_item &item);
 	UINT8 tile_draw(const UINT8 *pendata, UINT32 x0, UINT32 y0, UINT32 palette_base, UINT8 category, UINT8 group, UINT8 flags, UINT8 pen_mask);
 	UINT8 tile_apply_bitmask(const UINT8 *maskdata, UINT32 x0, UINT32 y0, UINT8 category, UINT8 flags);
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
@@ -673,6 +703,10 @@ private:
 	bitmap_ind8                 m_flagsmap;             // per-pixel flags
 	std::vector<UINT8>               m_tileflags;            // per-tile flags
 	UINT8                       m_pen_to_flags[MAX_PEN_TO_FLAGS * TILEMAP_NUM_GROUPS]; // mapping of pens to flags
+
+	// deferred tile rendering
+	std::vector<realize_item>   m_realize_list;         // dirty tiles gathered for rendering
+	std::vector<realize_batch>  m_realize_batches;      // batches queued to worker threads
 };
 
 
@@ -703,14 +737,31 @@ public:
 	void mark_all_dirty();
 	void set_flip_all(UINT32 attributes);
 
+	// realization statistics
+	UINT64 tiles_realized() const { return m_realize_total; }
+	UINT32 tiles_realized_peak() const { return m_realize_peak; }
+
 private:
 	// allocate an instance index
 	int alloc_instance() { return ++m_instance; }
 
+	// internal helpers
+	osd_work_queue *work_queue() const { return m_work_queue; }
+	void count_realized(UINT32 count);
+	void exit();
+
 	// internal state
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	osd_work_queue *        m_work_queue;           // queue for rendering tiles on worker threads
+
+	// realization statistics
+	UINT64                  m_realize_frame;        // frame number the current count applies to
+	UINT32                  m_realize_frame_count;  // tiles realized during the current frame
+	UINT32                  m_realize_peak;         // most tiles realized in a single frame
+	UINT64                  m_realize_frames;       // number of frames that realized any tiles
+	UINT64                  m_realize_total;        // total tiles realized
 };
 
 
@@ -111,6 +111,15 @@ video_manager::video_manager(running_machine &machine)
 		m_avi_next_frame_time(attotime::zero),
 		m_avi_frame(0),
 		m_dummy_recording(false),
+		m_encode_queue(nullptr),
+		m_mng_compression(machine.options().mng_compression()),
+		m_movie_last(nullptr),
+		m_movie_pending_avi(0),
+		m_movie_pending_mng(0),
+		m_movie_recorded(0),
+		m_movie_dropped(0),
+		m_avi_error(false),
+		m_mng_error(false),
 		m_timecode_enabled(false),
 		m_timecode_write(false),
 		m_timecode_text(""),
@@ -154,6 +163,12 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// set up the encoder thread and the movie frames that can wait for it
+	m_encode_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_encode_queue != nullptr)
+		for (int framenum = 0; framenum < machine.options().movie_queue(); framenum++)
+			m_movie_frames.push_back(std::make_unique<movie_frame>(*this));
+
 	// start recording movie if specified
 	const char *filename = machine.options().mng_write();
 	if (filename[0] != 0)
@@ -322,6 +337,21 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 	// create the bitmap to pass in
 	create_snapshot_bitmap(screen);
 
+	// now do the actual work
+	png_error error = write_snapshot(m_snap_bitmap, file);
+	if (error != PNGERR_NONE)
+		osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", error);
+}
+
+
+//-------------------------------------------------
+//  write_snapshot - write a snapshot bitmap as a
+//  PNG; runs on the encoder thread for queued
+//  snapshots
+//-------------------------------------------------
+
+png_error video_manager::write_snapshot(bitmap_rgb32 &bitmap, emu_file &file)
+{
 	// add two text entries describing the image
 	std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(build_version);
 	std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
@@ -329,15 +359,82 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 	png_add_text(&pnginfo, "Software", text1.c_str());
 	png_add_text(&pnginfo, "System", text2.c_str());
 
-	// now do the actual work
-	const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
-	int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-	png_error error = png_write_bitmap(file, &pnginfo, m_snap_bitmap, entries, palette);
-	if (error != PNGERR_NONE)
-		osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", error);
+	// the snapshot bitmap is RGB, so no palette is needed
+	png_error error = png_write_bitmap(file, &pnginfo, bitmap, 0, nullptr);
 
 	// free any data allocated
 	png_free(&pnginfo);
+	return error;
+}
+
+
+//-------------------------------------------------
+//  queue_snapshot - render a snapshot and hand it
+//  to the encoder thread along with its file
+//-------------------------------------------------
+
+void video_manager::queue_snapshot(screen_device *screen, std::unique_ptr<emu_file> &&file)
+{
+	// without an encoder thread, write it now
+	if (m_encode_queue == nullptr)
+		return save_snapshot(screen, *file);
+
+	// release finished snapshots, and wait for the oldest if too many are still pending
+	reap_snapshots(MAX_PENDING_SNAPSHOTS - 1);
+
+	// copy the bitmap so rendering can carry on while it is encoded
+	create_snapshot_bitmap(screen);
+	auto job = std::make_unique<snapshot_job>();
+	job->m_manager = this;
+	job->m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+	copybitmap(job->m_bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+	job->m_file = std::move(file);
+	job->m_error = PNGERR_NONE;
+
+	job->m_osd = osd_work_item_queue(m_encode_queue, snapshot_static, job.get(), 0);
+	if (job->m_osd == nullptr)
+	{
+		job->m_error = write_snapshot(job->m_bitmap, *job->m_file);
+		if (job->m_error != PNGERR_NONE)
+			osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", job->m_error);
+		return;
+	}
+	m_snapshots.push_back(std::move(job));
+}
+
+
+//-------------------------------------------------
+//  reap_snapshots - release snapshots the encoder
+//  has written, waiting for the oldest ones until
+//  no more than the given number are pending
+//-------------------------------------------------
+
+void video_manager::reap_snapshots(size_t keep)
+{
+	while (!m_snapshots.empty())
+	{
+		snapshot_job &job = *m_snapshots.front();
+		if (!osd_work_item_wait(job.m_osd, (m_snapshots.size() > keep) ? osd_ticks_per_second() * 100 : 0))
+			break;
+		osd_work_item_release(job.m_osd);
+		if (job.m_error != PNGERR_NONE)
+			osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", job.m_error);
+		m_snapshots.erase(m_snapshots.begin());
+	}
+}
+
+
+//-------------------------------------------------
+//  snapshot_static - write and close a queued
+//  snapshot on the encoder thread
+//-------------------------------------------------
+
+void *video_manager::snapshot_static(void *param, int threadid)
+{
+	snapshot_job &job = *reinterpret_cast<snapshot_job *>(param);
+	job.m_error = job.m_manager->write_snapshot(job.m_bitmap, *job.m_file);
+	job.m_file->close();
+	return nullptr;
 }
 
 
@@ -356,20 +453,20 @@ void video_manager::save_active_screen_snapshots()
 		for (screen_device *screen = iter.first(); screen != nullptr; screen = iter.next())
 			if (machine().render().is_live(*screen))
 			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				file_error filerr = open_next(file, "png");
+				auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+				file_error filerr = open_next(*file, "png");
 				if (filerr == FILERR_NONE)
-					save_snapshot(screen, file);
+					queue_snapshot(screen, std::move(file));
 			}
 	}
 
 	// otherwise, just write a single snapshot
 	else
 	{
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		file_error filerr = open_next(file, "png");
+		auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		file_error filerr = open_next(*file, "png");
 		if (filerr == FILERR_NONE)
-			save_snapshot(nullptr, file);
+			queue_snapshot(nullptr, std::move(file));
 	}
 }
 
@@ -547,6 +644,15 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 void video_manager::end_recording(movie_format format)
 {
+	// let the encoder write everything already queued
+	wait_movie_queue();
+
+	// append the last image in place of any frames dropped since it was queued
+	UINT32 avi_count = (format == MF_AVI && m_avi_file != nullptr) ? m_movie_pending_avi : 0;
+	UINT32 mng_count = (format == MF_MNG && m_mng_file != nullptr) ? m_movie_pending_mng : 0;
+	if (avi_count != 0 || mng_count != 0)
+		write_movie_frame((m_movie_last != nullptr) ? m_movie_last->m_bitmap : m_snap_bitmap, avi_count, mng_count, m_mng_frame - mng_count);
+
 	if (format == MF_AVI)
 	{
 		// close the file if it exists
@@ -558,6 +664,8 @@ void video_manager::end_recording(movie_format format)
 			// reset the state
 			m_avi_frame = 0;
 		}
+		m_movie_pending_avi = 0;
+		m_avi_error = false;
 	}
 	else if (format == MF_MNG)
 	{
@@ -570,7 +678,43 @@ void video_manager::end_recording(movie_format format)
 			// reset the state
 			m_mng_frame = 0;
 		}
+		m_movie_pending_mng = 0;
+		m_mng_error = false;
 	}
+
+	// once nothing is recording, report frames the encoder couldn't keep up with
+	if (m_avi_file == nullptr && m_mng_file == nullptr)
+	{
+		if (m_movie_dropped > 0)
+			osd_printf_warning("Movie encoder fell behind: %u of %u frames dropped (try a larger -moviequeue or lower -mngcompression)\n", m_movie_dropped, m_movie_recorded);
+		m_movie_recorded = 0;
+		m_movie_dropped = 0;
+		m_movie_last = nullptr;
+	}
+}
+
+
+//-------------------------------------------------
+//  wait_movie_queue - wait for the encoder thread
+//  to write every queued frame and sound chunk
+//-------------------------------------------------
+
+void video_manager::wait_movie_queue()
+{
+	if (m_encode_queue == nullptr)
+		return;
+
+	osd_work_queue_wait(m_encode_queue, osd_ticks_per_second() * 100);
+	for (auto &frame : m_movie_frames)
+		if (frame->m_osd != nullptr)
+		{
+			osd_work_item_wait(frame->m_osd, osd_ticks_per_second() * 100);
+			osd_work_item_release(frame->m_osd);
+			frame->m_osd = nullptr;
+		}
+	for (osd_work_item *item : m_movie_sounds)
+		osd_work_item_release(item);
+	m_movie_sounds.clear();
 }
 
 
@@ -586,12 +730,40 @@ void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 	{
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_error avierr = avi_append_sound_samples(m_avi_file, 0, sound + 0, numsamples, 1);
-		if (avierr == AVIERR_NONE)
-			avierr = avi_append_sound_samples(m_avi_file, 1, sound + 1, numsamples, 1);
-		if (avierr != AVIERR_NONE)
-			end_recording(MF_AVI);
+		// with an encoder thread, queue a copy so it stays in order with the frames
+		if (!m_movie_frames.empty())
+		{
+			// release chunks the encoder has finished with
+			while (!m_movie_sounds.empty() && osd_work_item_wait(m_movie_sounds.front(), 0))
+			{
+				osd_work_item_release(m_movie_sounds.front());
+				m_movie_sounds.erase(m_movie_sounds.begin());
+			}
+
+			movie_sound *chunk = new movie_sound;
+			chunk->m_manager = this;
+			chunk->m_samples.assign(sound, sound + numsamples * 2);
+			osd_work_item *item = osd_work_item_queue(m_encode_queue, movie_sound_static, chunk, 0);
+			if (item != nullptr)
+				m_movie_sounds.push_back(item);
+			else
+			{
+				// if it can't be queued, write it here once the encoder is idle
+				wait_movie_queue();
+				movie_sound_static(chunk, 0);
+				if (m_avi_error)
+					end_recording(MF_AVI);
+			}
+		}
+		else
+		{
+			// write the next frame
+			avi_error avierr = avi_append_sound_samples(m_avi_file, 0, sound + 0, numsamples, 1);
+			if (avierr == AVIERR_NONE)
+				avierr = avi_append_sound_samples(m_avi_file, 1, sound + 1, numsamples, 1);
+			if (avierr != AVIERR_NONE)
+				end_recording(MF_AVI);
+		}
 
 		g_profiler.stop();
 	}
@@ -609,6 +781,15 @@ void video_manager::exit()
 	end_recording(MF_AVI);
 	end_recording(MF_MNG);
 
+	// finish writing snapshots and free the encoder
+	reap_snapshots(0);
+	if (m_encode_queue != nullptr)
+	{
+		osd_work_queue_free(m_encode_queue);
+		m_encode_queue = nullptr;
+	}
+	m_movie_frames.clear();
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
@@ -1315,63 +1496,152 @@ void video_manager::record_frame()
 	// create the bitmap
 	create_snapshot_bitmap(nullptr);
 
-	// handle an AVI recording
+	// count the frames each movie needs to reach the right time
+	UINT32 avi_count = 0;
 	if (m_avi_file != nullptr)
-	{
-		// loop until we hit the right time
-		while (m_avi_next_frame_time <= curtime)
+		for ( ; m_avi_next_frame_time <= curtime; m_avi_next_frame_time += m_avi_frame_period)
 		{
-			// write the next frame
-			avi_error avierr = avi_append_video_frame(m_avi_file, m_snap_bitmap);
-			if (avierr != AVIERR_NONE)
-			{
-				g_profiler.stop();
-				end_recording(MF_AVI);
-				break;
-			}
-
-			// advance time
-			m_avi_next_frame_time += m_avi_frame_period;
+			avi_count++;
 			m_avi_frame++;
 		}
-	}
 
-	// handle a MNG recording
+	UINT32 mng_count = 0;
 	if (m_mng_file != nullptr)
+		for ( ; m_mng_next_frame_time <= curtime; m_mng_next_frame_time += m_mng_frame_period)
+		{
+			mng_count++;
+			m_mng_frame++;
+		}
+
+	if (avi_count != 0 || mng_count != 0)
 	{
-		// loop until we hit the right time
-		while (m_mng_next_frame_time <= curtime)
+		m_movie_recorded++;
+
+		// without an encoder thread, write them now
+		if (m_movie_frames.empty())
+			write_movie_frame(m_snap_bitmap, avi_count, mng_count, m_mng_frame - mng_count);
+		else
 		{
-			// set up the text fields in the movie info
-			png_info pnginfo = { nullptr };
-			if (m_mng_frame == 0)
-			{
-				std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(build_version);
-				std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
-				png_add_text(&pnginfo, "Software", text1.c_str());
-				png_add_text(&pnginfo, "System", text2.c_str());
-			}
+			// find a frame the encoder has finished with
+			movie_frame *frame = nullptr;
+			for (auto &slot : m_movie_frames)
+				if (slot->m_osd == nullptr || osd_work_item_wait(slot->m_osd, 0))
+				{
+					frame = slot.get();
+					break;
+				}
 
-			// write the next frame
-			screen_device *screen = machine().first_screen();
-			const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
-			int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-			png_error error = mng_capture_frame(*m_mng_file, &pnginfo, m_snap_bitmap, entries, palette);
-			png_free(&pnginfo);
-			if (error != PNGERR_NONE)
+			// if the encoder is behind, drop this image and repeat the next one in its place
+			if (frame == nullptr)
 			{
-				g_profiler.stop();
-				end_recording(MF_MNG);
-				break;
+				m_movie_dropped++;
+				m_movie_pending_avi += avi_count;
+				m_movie_pending_mng += mng_count;
 			}
+			else
+			{
+				if (frame->m_osd != nullptr)
+				{
+					osd_work_item_release(frame->m_osd);
+					frame->m_osd = nullptr;
+				}
 
-			// advance time
-			m_mng_next_frame_time += m_mng_frame_period;
-			m_mng_frame++;
+				// copy the snapshot so rendering can carry on while it is encoded
+				if (frame->m_bitmap.width() != m_snap_bitmap.width() || frame->m_bitmap.height() != m_snap_bitmap.height())
+					frame->m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+				copybitmap(frame->m_bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+
+				frame->m_avi_count = avi_count + m_movie_pending_avi;
+				frame->m_mng_count = mng_count + m_movie_pending_mng;
+				frame->m_mng_frame = m_mng_frame - frame->m_mng_count;
+				m_movie_pending_avi = m_movie_pending_mng = 0;
+
+				m_movie_last = frame;
+				frame->m_osd = osd_work_item_queue(m_encode_queue, movie_frame_static, frame, 0);
+				if (frame->m_osd == nullptr)
+					write_movie_frame(frame->m_bitmap, frame->m_avi_count, frame->m_mng_count, frame->m_mng_frame);
+			}
 		}
 	}
 
 	g_profiler.stop();
+
+	// stop any movie that failed to write
+	if (m_avi_error)
+		end_recording(MF_AVI);
+	if (m_mng_error)
+		end_recording(MF_MNG);
+}
+
+
+//-------------------------------------------------
+//  write_movie_frame - append a frame to the open
+//  movies the given number of times; runs on the
+//  encoder thread when there is one
+//-------------------------------------------------
+
+void video_manager::write_movie_frame(bitmap_rgb32 &bitmap, UINT32 avi_count, UINT32 mng_count, UINT32 mng_frame)
+{
+	// handle an AVI recording
+	for (UINT32 count = 0; count < avi_count && !m_avi_error; count++)
+		if (avi_append_video_frame(m_avi_file, bitmap) != AVIERR_NONE)
+			m_avi_error = true;
+
+	// handle a MNG recording
+	for (UINT32 count = 0; count < mng_count && !m_mng_error; count++)
+	{
+		// set up the text fields in the movie info
+		png_info pnginfo = { nullptr };
+		if (mng_frame + count == 0)
+		{
+			std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(build_version);
+			std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
+			png_add_text(&pnginfo, "Software", text1.c_str());
+			png_add_text(&pnginfo, "System", text2.c_str());
+		}
+
+		// write the next frame; the snapshot bitmap is RGB so no palette is needed
+		png_error error = mng_capture_frame(*m_mng_file, &pnginfo, bitmap, 0, nullptr, m_mng_compression);
+		png_free(&pnginfo);
+		if (error != PNGERR_NONE)
+			m_mng_error = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  movie_frame_static - encode a queued frame on
+//  the encoder thread
+//-------------------------------------------------
+
+void *video_manager::movie_frame_static(void *param, int threadid)
+{
+	movie_frame &frame = *reinterpret_cast<movie_frame *>(param);
+	frame.m_manager.write_movie_frame(frame.m_bitmap, frame.m_avi_count, frame.m_mng_count, frame.m_mng_frame);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  movie_sound_static - write queued sound to the
+//  AVI on the encoder thread
+//-------------------------------------------------
+
+void *video_manager::movie_sound_static(void *param, int threadid)
+{
+	movie_sound *chunk = reinterpret_cast<movie_sound *>(param);
+	video_manager &manager = *chunk->m_manager;
+	if (manager.m_avi_file != nullptr && !manager.m_avi_error)
+	{
+		const int numsamples = chunk->m_samples.size() / 2;
+		avi_error avierr = avi_append_sound_samples(manager.m_avi_file, 0, &chunk->m_samples[0], numsamples, 1);
+		if (avierr == AVIERR_NONE)
+			avierr = avi_append_sound_samples(manager.m_avi_file, 1, &chunk->m_samples[1], numsamples, 1);
+		if (avierr != AVIERR_NONE)
+			manager.m_avi_error = true;
+	}
+	delete chunk;
+	return nullptr;
 }
 
 //-------------------------------------------------
@@ -17,6 +17,8 @@
 #ifndef __VIDEO_H__
 #define __VIDEO_H__
 
+#include <atomic>
+#include "png.h"
 
 //**************************************************************************
 //  CONSTANTS
@@ -130,7 +132,45 @@ private:
 
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
+	png_error write_snapshot(bitmap_rgb32 &bitmap, emu_file &file);
+	void queue_snapshot(screen_device *screen, std::unique_ptr<emu_file> &&file);
+	void reap_snapshots(size_t keep);
+	static void *snapshot_static(void *param, int threadid);
 	void record_frame();
+	void write_movie_frame(bitmap_rgb32 &bitmap, UINT32 avi_count, UINT32 mng_count, UINT32 mng_frame);
+	void wait_movie_queue();
+	static void *movie_frame_static(void *param, int threadid);
+	static void *movie_sound_static(void *param, int threadid);
+
+	// a frame waiting for the movie encoder
+	struct movie_frame
+	{
+		movie_frame(video_manager &manager) : m_manager(manager), m_avi_count(0), m_mng_count(0), m_mng_frame(0), m_osd(nullptr) { }
+
+		video_manager &     m_manager;                  // reference back to the manager
+		bitmap_rgb32        m_bitmap;                   // copy of the snapshot bitmap
+		UINT32              m_avi_count;                // number of times to append it to the AVI
+		UINT32              m_mng_count;                // number of times to append it to the MNG
+		UINT32              m_mng_frame;                // MNG frame number of the first append
+		osd_work_item *     m_osd;                      // encode in progress
+	};
+
+	// sound waiting for the movie encoder
+	struct movie_sound
+	{
+		video_manager *     m_manager;                  // pointer back to the manager
+		std::vector<INT16>  m_samples;                  // interleaved stereo samples
+	};
+
+	// a snapshot waiting for the encoder
+	struct snapshot_job
+	{
+		video_manager *     m_manager;                  // pointer back to the manager
+		bitmap_rgb32        m_bitmap;                   // copy of the snapshot bitmap
+		std::unique_ptr<emu_file> m_file;               // file opened for it
+		png_error           m_error;                    // result of writing it
+		osd_work_item *     m_osd;                      // encode in progress
+	};
 
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
@@ -196,8 +236,24 @@ private:
 	// movie recording - dummy
 	bool                m_dummy_recording;          // indicates if snapshot should be created of every frame
 
+	// encoder thread for movies and snapshots
+	osd_work_queue *    m_encode_queue;             // queue for encoding and writing in order
+	std::vector<std::unique_ptr<snapshot_job>> m_snapshots; // snapshots being written, oldest first
+	std::vector<std::unique_ptr<movie_frame>> m_movie_frames; // frames that can be waiting at once
+	int                 m_mng_compression;          // zlib level for MNG frames
+	movie_frame *       m_movie_last;               // frame most recently copied for the encoder
+	std::vector<osd_work_item *> m_movie_sounds;    // sound chunks being written, oldest first
+	UINT32              m_movie_pending_avi;        // AVI appends owed by dropped frames
+	UINT32              m_movie_pending_mng;        // MNG appends owed by dropped frames
+	UINT32              m_movie_recorded;           // frames recorded since the last reset
+	UINT32              m_movie_dropped;            // frames dropped because the encoder was behind
+	std::atomic<bool>   m_avi_error;                // did the encoder fail writing the AVI?
+	std::atomic<bool>   m_mng_error;                // did the encoder fail writing the MNG?
+
 	static const UINT8      s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
+	static const size_t MAX_PENDING_SNAPSHOTS = 4;
+
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
 	static const int PAUSED_REFRESH_RATE = 30;
 
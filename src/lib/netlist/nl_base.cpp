@@ -95,10 +95,15 @@ void queue_t::on_pre_save()
 	netlist().log().debug("on_pre_save\n");
 	m_qsize = this->count();
 	netlist().log().debug("current time {1} qsize {2}\n", netlist().time().as_double(), m_qsize);
+	/* saved last to be processed first: pushing them back in this order
+	 * restores the order of equal times
+	 */
+	this->sort();
 	for (int i = 0; i < m_qsize; i++ )
 	{
-		m_times[i] =  this->listptr()[i].exec_time().as_raw();
-		pstring p = this->listptr()[i].object()->name();
+		const queue_t::entry_t &e = this->listptr()[m_qsize - 1 - i];
+		m_times[i] =  e.exec_time().as_raw();
+		pstring p = e.object()->name();
 		int n = p.len();
 		n = std::min(63, n);
 		std::strncpy(m_names[i].m_buf, p.cstr(), n);
@@ -10,6 +10,8 @@
 #ifndef NLLISTS_H_
 #define NLLISTS_H_
 
+#include <algorithm>
+
 #include "nl_config.h"
 #include "plib/plists.h"
 
@@ -19,6 +21,14 @@
 
 namespace netlist
 {
+	/* The queue is a 4-ary min-heap ordered by execution time. Each push gets
+	 * a sequence number which breaks ties: of entries with equal times the
+	 * one pushed last is returned first, as with the sorted array used
+	 * before. Logic loops with zero delay depend on this order. A 4-ary heap
+	 * is half as deep as a binary one, so a push or pop moves fewer entries.
+	 * The four children of a node are adjacent in memory.
+	 */
+
 	template <class _Element, class _Time>
 	class timed_queue
 	{
@@ -27,22 +37,33 @@ namespace netlist
 
 		class entry_t
 		{
+			friend class timed_queue;
 		public:
 			ATTR_HOT  entry_t()
-			:  m_exec_time(), m_object() {}
-			ATTR_HOT  entry_t(const _Time &atime, const _Element &elem) : m_exec_time(atime), m_object(elem)  {}
+			:  m_exec_time(), m_object(), m_seq(0) {}
+			ATTR_HOT  entry_t(const _Time &atime, const _Element &elem) : m_exec_time(atime), m_object(elem), m_seq(0)  {}
 			ATTR_HOT  const _Time &exec_time() const { return m_exec_time; }
 			ATTR_HOT  const _Element &object() const { return m_object; }
 
 			ATTR_HOT  entry_t &operator=(const entry_t &right) {
 				m_exec_time = right.m_exec_time;
 				m_object = right.m_object;
+				m_seq = right.m_seq;
 				return *this;
 			}
 
+			/* pop order */
+			ATTR_HOT  bool before(const entry_t &right) const
+			{
+				if (m_exec_time != right.m_exec_time)
+					return m_exec_time < right.m_exec_time;
+				return m_seq > right.m_seq;
+			}
+
 		private:
 			_Time m_exec_time;
 			_Element m_object;
+			UINT64 m_seq;
 		};
 
 		timed_queue(unsigned list_size)
@@ -55,8 +76,8 @@ namespace netlist
 		}
 
 		ATTR_HOT  std::size_t capacity() const { return m_list.size(); }
-		ATTR_HOT  bool is_empty() const { return (m_end == &m_list[1]); }
-		ATTR_HOT  bool is_not_empty() const { return (m_end > &m_list[1]); }
+		ATTR_HOT  bool is_empty() const { return (m_count == 0); }
+		ATTR_HOT  bool is_not_empty() const { return (m_count > 0); }
 
 		ATTR_HOT void push(const entry_t &e)
 		{
@@ -64,30 +85,32 @@ namespace netlist
 			/* Lock */
 			while (atomic_exchange32(&m_lock, 1)) { }
 	#endif
-			const _Time t = e.exec_time();
-			entry_t * i = m_end++;
-			while (t > (i - 1)->exec_time())
-			{
-				*(i) = *(i-1);
-				i--;
-				inc_stat(m_prof_sortmove);
-			}
-			*i = e;
+			//nl_assert(m_count < m_list.size());
+			entry_t n = e;
+			n.m_seq = m_seq++;
+			sift_up(m_count++, n);
 			inc_stat(m_prof_call);
 	#if HAS_OPENMP && USE_OPENMP
 			m_lock = 0;
 	#endif
-			//nl_assert(m_end - m_list < _Size);
 		}
 
+		/* The returned entry stays valid until the next push */
 		ATTR_HOT  const entry_t *pop()
 		{
-			return --m_end;
+			const unsigned last = --m_count;
+			if (last > 0)
+			{
+				const entry_t e = m_list[last];
+				m_list[last] = m_list[0];
+				sift_down(0, e);
+			}
+			return &m_list[last];
 		}
 
 		ATTR_HOT  const entry_t *peek() const
 		{
-			return (m_end-1);
+			return &m_list[0];
 		}
 
 		ATTR_HOT  void remove(const _Element &elem)
@@ -96,23 +119,21 @@ namespace netlist
 	#if HAS_OPENMP && USE_OPENMP
 			while (atomic_exchange32(&m_lock, 1)) { }
 	#endif
-			entry_t * i = m_end - 1;
-			while (i > &m_list[0])
+			for (unsigned i = 0; i < m_count; i++)
 			{
-				if (i->object() == elem)
+				if (m_list[i].object() == elem)
 				{
-					m_end--;
-					while (i < m_end)
+					const unsigned last = --m_count;
+					if (i < last)
 					{
-						*i = *(i+1);
-						i++;
+						const entry_t e = m_list[last];
+						if (i > 0 && e.before(m_list[(i - 1) / 4]))
+							sift_up(i, e);
+						else
+							sift_down(i, e);
 					}
-	#if HAS_OPENMP && USE_OPENMP
-					m_lock = 0;
-	#endif
-					return;
+					break;
 				}
-				i--;
 			}
 	#if HAS_OPENMP && USE_OPENMP
 			m_lock = 0;
@@ -121,20 +142,25 @@ namespace netlist
 
 		ATTR_COLD void clear()
 		{
-			m_end = &m_list[0];
-			/* put an empty element with maximum time into the queue.
-			 * the insert algo above will run into this element and doesn't
-			 * need a comparison with queue start.
-			 */
-			m_list[0] = entry_t(_Time::from_raw(~0), _Element(0));
-			m_end++;
+			m_count = 0;
+			m_seq = 0;
 		}
 
 		// save state support & mame disasm
 
-		ATTR_COLD  const entry_t *listptr() const { return &m_list[1]; }
-		ATTR_HOT  int count() const { return m_end - &m_list[1]; }
-		ATTR_HOT  const entry_t & operator[](const int & index) const { return m_list[1+index]; }
+		/* Sort the entries into pop order. A sorted array is a valid heap,
+		 * so listptr() and operator[] return the entries in the order they
+		 * will be processed afterwards.
+		 */
+		ATTR_COLD void sort()
+		{
+			std::sort(&m_list[0], &m_list[0] + m_count,
+					[](const entry_t &a, const entry_t &b) { return a.before(b); });
+		}
+
+		ATTR_COLD  const entry_t *listptr() const { return &m_list[0]; }
+		ATTR_HOT  int count() const { return m_count; }
+		ATTR_HOT  const entry_t & operator[](const int & index) const { return m_list[index]; }
 
 	#if (NL_KEEP_STATISTICS)
 		// profiling
@@ -144,11 +170,49 @@ namespace netlist
 
 	private:
 
+		/* move the hole at index i towards the root until e fits */
+		ATTR_HOT void sift_up(unsigned i, const entry_t &e)
+		{
+			while (i > 0)
+			{
+				const unsigned parent = (i - 1) / 4;
+				if (!e.before(m_list[parent]))
+					break;
+				m_list[i] = m_list[parent];
+				i = parent;
+				inc_stat(m_prof_sortmove);
+			}
+			m_list[i] = e;
+		}
+
+		/* move the hole at index i towards the leaves until e fits */
+		ATTR_HOT void sift_down(unsigned i, const entry_t &e)
+		{
+			const unsigned n = m_count;
+			for (;;)
+			{
+				const unsigned first = 4 * i + 1;
+				if (first >= n)
+					break;
+				const unsigned end = std::min(first + 4, n);
+				unsigned best = first;
+				for (unsigned c = first + 1; c < end; c++)
+					if (m_list[c].before(m_list[best]))
+						best = c;
+				if (!m_list[best].before(e))
+					break;
+				m_list[i] = m_list[best];
+				i = best;
+				inc_stat(m_prof_sortmove);
+			}
+			m_list[i] = e;
+		}
+
 	#if HAS_OPENMP && USE_OPENMP
 		volatile INT32 m_lock;
 	#endif
-		entry_t * m_end;
-		//entry_t m_list[_Size];
+		unsigned m_count;
+		UINT64 m_seq;
 		parray_t<entry_t> m_list;
 
 	};
@@ -104,7 +104,7 @@ public:
 		opt_logs("l", "logs",        "",      "colon separated list of terminals to log", this),
 		opt_file("f", "file",        "-",     "file to process (default is stdin)", this),
 		opt_type("y", "type",        "spice", "spice:eagle", "type of file to be converted: spice,eagle", this),
-		opt_cmd ("c", "cmd",         "run",   "run|convert|listdevices", this),
+		opt_cmd ("c", "cmd",         "run",   "run|convert|listdevices|static", this),
 		opt_inp( "i", "input",       "",      "input file to process (default is none)", this),
 		opt_verb("v", "verbose",              "be verbose - this produces lots of output", this),
 		opt_quiet("q", "quiet",               "be quiet - no warnings", this),
@@ -320,6 +320,39 @@ static void run(tool_options_t &opts)
 	pout("{1:f} seconds emulation took {2:f} real time ==> {3:5.2f}%\n", ttr, emutime, ttr/emutime*100.0);
 }
 
+/*-------------------------------------------------
+    static_compile - write C++ code for the matrix
+    solvers of a netlist to stdout. Compiled into
+    the driver and included from its netlist with
+    LOCAL_SOURCE(static_solvers) and
+    INCLUDE(static_solvers), solvers with the same
+    structure use it instead of the generic
+    elimination code.
+-------------------------------------------------*/
+
+static void static_compile(tool_options_t &opts)
+{
+	netlist_tool_t nt;
+
+	nt.m_opts = &opts;
+	nt.init();
+
+	/* the log goes to stdout as well */
+	nt.log().info.set_enabled(false);
+	nt.log().verbose.set_enabled(false);
+	nt.log().warning.set_enabled(false);
+
+	nt.read_netlist(opts.opt_file(), opts.opt_name());
+
+	if (nt.solver() == NULL)
+		throw netlist::fatalerror_e("netlist has no solver\n");
+	/* name the netlist after the one compiled, so several can be linked */
+	const pstring name = (opts.opt_name() == "") ? pstring("static_solvers") : "static_solvers_" + opts.opt_name();
+	nt.solver()->create_solver_code(pout_strm, name);
+
+	nt.stop();
+}
+
 /*-------------------------------------------------
     listdevices - list all known devices
 -------------------------------------------------*/
@@ -418,6 +451,8 @@ int main(int argc, char *argv[])
 		listdevices();
 	else if (cmd == "run")
 		run(opts);
+	else if (cmd == "static")
+		static_compile(opts);
 	else if (cmd == "convert")
 	{
 		pstring contents;
@@ -30,6 +30,10 @@ public:
 
 	virtual void vsetup(analog_net_t::list_t &nets) override;
 	virtual void reset() override { matrix_solver_t::reset(); }
+	virtual void log_stats() override;
+
+	virtual pstring static_compile_name() override;
+	virtual void create_solver_code(postream &strm) override;
 
 	ATTR_HOT inline unsigned N() const { if (m_N == 0) return m_dim; else return m_N; }
 
@@ -41,11 +45,20 @@ protected:
 	ATTR_HOT virtual nl_double vsolve() override;
 
 	ATTR_HOT int solve_non_dynamic(const bool newton_raphson);
+	ATTR_HOT int store_solution(const bool newton_raphson, const nl_double * RESTRICT V);
 	ATTR_HOT void build_LE_A();
 	ATTR_HOT void build_LE_RHS(nl_double * RESTRICT rhs);
 	ATTR_HOT void LE_solve();
 	ATTR_HOT void LE_back_subst(nl_double * RESTRICT x);
 
+	/* Without pivoting the elimination order is fixed at setup time. m_A
+	 * keeps the eliminated matrix and LE_solve() records the multipliers,
+	 * so as long as the conductances do not change only the right hand
+	 * side has to be run through the elimination.
+	 */
+	ATTR_HOT bool LE_factorisation_valid();
+	ATTR_HOT void LE_forward_subst();
+
 	/* Full LU back substitution, not used currently, in for future use */
 
 	ATTR_HOT void LE_back_subst_full(nl_double * RESTRICT x);
@@ -69,6 +82,15 @@ protected:
 	terms_t **m_terms;
 	terms_t *m_rails_temp;
 
+	bool m_lu_valid;
+	plist_t<nl_double> m_lu_terms;  // gt/go values m_A was eliminated for
+	plist_t<nl_double> m_lu_f;      // multipliers in elimination order
+	int m_stat_lu_reuse;
+	int m_stat_lu_factor;
+
+	/* LE_solve() and LE_back_subst() unrolled by "nltool -c static" */
+	static_solver_fp m_static_solver;
+
 private:
 	ATTR_ALIGN nl_ext_double m_A[_storage_N][((_storage_N + 7) / 8) * 8];
 
@@ -300,6 +322,27 @@ ATTR_COLD void matrix_solver_direct_t<m_N, _storage_N>::vsetup(analog_net_t::lis
 			log().verbose("{1}", line);
 		}
 
+	/* room for the factorisation cache */
+	m_lu_valid = false;
+	m_lu_terms.clear();
+	m_lu_f.clear();
+	for (unsigned k = 0; k < N(); k++)
+	{
+		for (unsigned i = 0; i < m_terms[k]->count() + m_terms[k]->m_railstart; i++)
+			m_lu_terms.add(0.0);
+		for (unsigned i = 0; i < m_terms[k]->m_nzbd.size(); i++)
+			m_lu_f.add(0.0);
+	}
+
+	/* compiled code for this structure linked in? */
+	m_static_solver = NULL;
+	if (!m_params.m_pivot)
+	{
+		m_static_solver = static_solver_list_t::find(static_compile_name());
+		if (m_static_solver != NULL)
+			log().verbose("Solver {1} uses static solver {2}", this->name(), static_compile_name());
+	}
+
 	/*
 	 * save states
 	 */
@@ -323,6 +366,8 @@ template <unsigned m_N, unsigned _storage_N>
 ATTR_HOT void matrix_solver_direct_t<m_N, _storage_N>::build_LE_A()
 {
 	const unsigned iN = N();
+
+	m_lu_valid = false;
 	for (unsigned k = 0; k < iN; k++)
 	{
 		for (unsigned i=0; i < iN; i++)
@@ -377,6 +422,7 @@ template <unsigned m_N, unsigned _storage_N>
 ATTR_HOT void matrix_solver_direct_t<m_N, _storage_N>::LE_solve()
 {
 	const unsigned kN = N();
+	nl_double * RESTRICT lu_f = m_lu_f.data();
 
 	for (unsigned i = 0; i < kN; i++) {
 		// FIXME: use a parameter to enable pivoting? m_pivot
@@ -435,11 +481,63 @@ ATTR_HOT void matrix_solver_direct_t<m_N, _storage_N>::LE_solve()
 					A(j,p[k]) += A(i,p[k]) * f1;
 				}
 				m_RHS[j] += m_RHS[i] * f1;
+				*lu_f++ = f1;
 			}
 		}
 	}
 }
 
+template <unsigned m_N, unsigned _storage_N>
+ATTR_HOT bool matrix_solver_direct_t<m_N, _storage_N>::LE_factorisation_valid()
+{
+	if (m_params.m_pivot)
+		return false;
+
+	/* compare against the conductances of the last elimination and
+	 * remember the current ones if they differ
+	 */
+	bool valid = m_lu_valid;
+	nl_double * RESTRICT last = m_lu_terms.data();
+	for (unsigned k = 0, iN = N(); k < iN; k++)
+	{
+		const unsigned terms_count = m_terms[k]->count();
+		const unsigned railstart = m_terms[k]->m_railstart;
+		const nl_double * RESTRICT gt = m_terms[k]->gt();
+		const nl_double * RESTRICT go = m_terms[k]->go();
+
+		for (unsigned i = 0; i < terms_count; i++, last++)
+			if (*last != gt[i])
+			{
+				*last = gt[i];
+				valid = false;
+			}
+		for (unsigned i = 0; i < railstart; i++, last++)
+			if (*last != go[i])
+			{
+				*last = go[i];
+				valid = false;
+			}
+	}
+	return valid;
+}
+
+template <unsigned m_N, unsigned _storage_N>
+ATTR_HOT void matrix_solver_direct_t<m_N, _storage_N>::LE_forward_subst()
+{
+	const nl_double * RESTRICT lu_f = m_lu_f.data();
+
+	/* same order of operations as LE_solve(), so the results are identical */
+	for (unsigned i = 0, kN = N(); i < kN; i++)
+	{
+		const unsigned * RESTRICT const pb = m_terms[i]->m_nzbd.data();
+		const unsigned eb = m_terms[i]->m_nzbd.size();
+		const nl_double rhsi = m_RHS[i];
+
+		for (unsigned jb = 0; jb < eb; jb++)
+			m_RHS[pb[jb]] += rhsi * *lu_f++;
+	}
+}
+
 template <unsigned m_N, unsigned _storage_N>
 ATTR_HOT void matrix_solver_direct_t<m_N, _storage_N>::LE_back_subst(
 		nl_double * RESTRICT x)
@@ -551,17 +649,23 @@ ATTR_HOT int matrix_solver_direct_t<m_N, _storage_N>::solve_non_dynamic(ATTR_UNU
 
 	this->LE_back_subst(new_V);
 
+	return this->store_solution(newton_raphson, new_V);
+}
+
+template <unsigned m_N, unsigned _storage_N>
+ATTR_HOT int matrix_solver_direct_t<m_N, _storage_N>::store_solution(const bool newton_raphson, const nl_double * RESTRICT V)
+{
 	if (newton_raphson)
 	{
-		nl_double err = delta(new_V);
+		nl_double err = delta(V);
 
-		store(new_V);
+		store(V);
 
 		return (err > this->m_params.m_accuracy) ? 2 : 1;
 	}
 	else
 	{
-		store(new_V);
+		store(V);
 		return 1;
 	}
 }
@@ -569,20 +673,127 @@ ATTR_HOT int matrix_solver_direct_t<m_N, _storage_N>::solve_non_dynamic(ATTR_UNU
 template <unsigned m_N, unsigned _storage_N>
 ATTR_HOT inline int matrix_solver_direct_t<m_N, _storage_N>::vsolve_non_dynamic(const bool newton_raphson)
 {
-	this->build_LE_A();
+	const bool reuse = this->LE_factorisation_valid();
+
+	if (!reuse)
+		this->build_LE_A();
 	this->build_LE_RHS(m_last_RHS);
 
 	for (unsigned i=0, iN=N(); i < iN; i++)
 		m_RHS[i] = m_last_RHS[i];
 
-	this->LE_solve();
+	if (reuse)
+	{
+		this->LE_forward_subst();
+		m_stat_lu_reuse++;
+	}
+	else if (m_static_solver != NULL)
+	{
+		nl_double new_V[_storage_N];
+
+		m_static_solver(&m_A[0][0], m_RHS, m_lu_f.data(), new_V);
+		m_lu_valid = true;
+		m_stat_lu_factor++;
+		return this->store_solution(newton_raphson, new_V);
+	}
+	else
+	{
+		this->LE_solve();
+		m_lu_valid = !m_params.m_pivot;
+		m_stat_lu_factor++;
+	}
 
 	return this->solve_non_dynamic(newton_raphson);
 }
 
+template <unsigned m_N, unsigned _storage_N>
+void matrix_solver_direct_t<m_N, _storage_N>::log_stats()
+{
+	matrix_solver_t::log_stats();
+	if (m_stat_lu_reuse + m_stat_lu_factor != 0 && this->m_params.m_log_stats)
+		log().verbose("       {1:10} eliminations, {2:10} reused ({3:6.2} %)", m_stat_lu_factor, m_stat_lu_reuse,
+				100.0 * (double) m_stat_lu_reuse / (double) (m_stat_lu_reuse + m_stat_lu_factor));
+}
+
+template <unsigned m_N, unsigned _storage_N>
+pstring matrix_solver_direct_t<m_N, _storage_N>::static_compile_name()
+{
+	const unsigned pitch = sizeof(m_A[0]) / sizeof(m_A[0][0]);
+
+	/* the iterative solvers derive from this class but do not eliminate */
+	if (this->type() != GAUSSIAN_ELIMINATION)
+		return "";
+
+	/* the generated code depends on the size, the row pitch of m_A and the
+	 * elimination pattern only - fold them into a FNV-1a hash
+	 */
+	UINT64 hash = U64(14695981039346656037);
+	const unsigned header[2] = { N(), pitch };
+	for (unsigned i = 0; i < 2; i++)
+		hash = (hash ^ header[i]) * U64(1099511628211);
+	for (unsigned k = 0; k < N(); k++)
+	{
+		for (unsigned i = 0; i < m_terms[k]->m_nzrd.size(); i++)
+			hash = (hash ^ m_terms[k]->m_nzrd[i]) * U64(1099511628211);
+		hash = (hash ^ 0xffff) * U64(1099511628211);
+		for (unsigned i = 0; i < m_terms[k]->m_nzbd.size(); i++)
+			hash = (hash ^ m_terms[k]->m_nzbd[i]) * U64(1099511628211);
+		hash = (hash ^ 0xfffe) * U64(1099511628211);
+	}
+	return pfmt("nl_gcr_{1}_{2}")(N()).x(hash);
+}
+
+template <unsigned m_N, unsigned _storage_N>
+void matrix_solver_direct_t<m_N, _storage_N>::create_solver_code(postream &strm)
+{
+	const unsigned pitch = sizeof(m_A[0]) / sizeof(m_A[0][0]);
+	const unsigned iN = N();
+	unsigned lu_idx = 0;
+
+	/* same operations in the same order as LE_solve() and LE_back_subst(),
+	 * so the results do not change
+	 */
+	strm.writeline(pfmt("// {1}: {2} nets")(this->name())(iN));
+	strm.writeline(pfmt("static void {1}(double * RESTRICT A, double * RESTRICT RHS, double * RESTRICT lu_f, double * RESTRICT V)")(static_compile_name()));
+	strm.writeline("{");
+	for (unsigned i = 0; i < iN; i++)
+	{
+		const plist_t<unsigned> &p = m_terms[i]->m_nzrd;
+		const plist_t<unsigned> &pb = m_terms[i]->m_nzbd;
+
+		if (pb.size() == 0)
+			continue;
+		strm.writeline(pfmt("\tconst double f{1} = 1.0 / A[{2}];")(i)(i * pitch + i));
+		for (unsigned jb = 0; jb < pb.size(); jb++)
+		{
+			const unsigned j = pb[jb];
+			strm.writeline(pfmt("\tconst double f{1}_{2} = -f{3} * A[{4}];")(i)(j)(i)(j * pitch + i));
+			for (unsigned k = 0; k < p.size(); k++)
+				strm.writeline(pfmt("\tA[{1}] += A[{2}] * f{3}_{4};")(j * pitch + p[k])(i * pitch + p[k])(i)(j));
+			strm.writeline(pfmt("\tRHS[{1}] += RHS[{2}] * f{3}_{4};")(j)(i)(i)(j));
+			strm.writeline(pfmt("\tlu_f[{1}] = f{2}_{3};")(lu_idx++)(i)(j));
+		}
+	}
+	strm.writeline("\tdouble tmp;");
+	for (int j = iN - 1; j >= 0; j--)
+	{
+		const plist_t<unsigned> &p = m_terms[j]->m_nzrd;
+
+		strm.writeline("\ttmp = 0.0;");
+		for (unsigned k = 0; k < p.size(); k++)
+			strm.writeline(pfmt("\ttmp += A[{1}] * V[{2}];")(j * pitch + p[k])(p[k]));
+		strm.writeline(pfmt("\tV[{1}] = (RHS[{2}] - tmp) / A[{3}];")(j)(j)(j * pitch + j));
+	}
+	strm.writeline("}");
+}
+
 template <unsigned m_N, unsigned _storage_N>
 matrix_solver_direct_t<m_N, _storage_N>::matrix_solver_direct_t(const solver_parameters_t *params, const int size)
 : matrix_solver_t(GAUSSIAN_ELIMINATION, params)
+, m_lu_valid(false)
+, m_stat_lu_reuse(0)
+, m_stat_lu_factor(0)
+, m_static_solver(NULL)
 , m_dim(size)
 {
 	m_terms = palloc_array(terms_t *, N());
@@ -599,6 +810,10 @@ matrix_solver_direct_t<m_N, _storage_N>::matrix_solver_direct_t(const solver_par
 template <unsigned m_N, unsigned _storage_N>
 matrix_solver_direct_t<m_N, _storage_N>::matrix_solver_direct_t(const eSolverType type, const solver_parameters_t *params, const int size)
 : matrix_solver_t(type, params)
+, m_lu_valid(false)
+, m_stat_lu_reuse(0)
+, m_stat_lu_factor(0)
+, m_static_solver(NULL)
 , m_dim(size)
 {
 	m_terms = palloc_array(terms_t *, N());
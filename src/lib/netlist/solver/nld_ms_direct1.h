@@ -21,6 +21,8 @@ public:
 		: matrix_solver_direct_t<1, 1>(params, 1)
 		{}
 	ATTR_HOT inline int vsolve_non_dynamic(const bool newton_raphson);
+	/* solved in closed form, nothing to compile */
+	virtual pstring static_compile_name() override { return ""; }
 protected:
 	ATTR_HOT virtual nl_double vsolve() override;
 private:
@@ -41,9 +41,6 @@
 //#include "nld_twoterm.h"
 #include "nl_lists.h"
 
-#if HAS_OPENMP
-#include "omp.h"
-#endif
 
 NETLIB_NAMESPACE_DEVICES_START()
 
@@ -92,8 +89,12 @@ ATTR_COLD matrix_solver_t::matrix_solver_t(const eSolverType type, const solver_
 	m_stat_vsolver_calls(0),
 	m_iterative_fail(0),
 	m_iterative_total(0),
+	m_stat_solve_ticks(0),
 	m_params(*params),
 	m_cur_ts(0),
+	m_next_ts(0),
+	m_solved(false),
+	m_resched_pending(false),
 	m_type(type)
 {
 }
@@ -244,37 +245,7 @@ ATTR_HOT void matrix_solver_t::step(const netlist_time delta)
 		m_step_devices[k]->step_time(dd);
 }
 
-template<class C >
-void matrix_solver_t::solve_base(C *p)
-{
-	m_stat_vsolver_calls++;
-	if (is_dynamic())
-	{
-		int this_resched;
-		int newton_loops = 0;
-		do
-		{
-			update_dynamic();
-			// Gauss-Seidel will revert to Gaussian elemination if steps exceeded.
-			this_resched = p->vsolve_non_dynamic(true);
-			newton_loops++;
-		} while (this_resched > 1 && newton_loops < m_params.m_nr_loops);
-
-		m_stat_newton_raphson += newton_loops;
-		// reschedule ....
-		if (this_resched > 1 && !m_Q_sync.net().is_queued())
-		{
-			log().warning("NEWTON_LOOPS exceeded on net {1}... reschedule", this->name());
-			m_Q_sync.net().reschedule_in_queue(m_params.m_nt_sync_delay);
-		}
-	}
-	else
-	{
-		p->vsolve_non_dynamic(false);
-	}
-}
-
-ATTR_HOT nl_double matrix_solver_t::solve()
+ATTR_HOT void matrix_solver_t::solve_compute()
 {
 	const netlist_time now = netlist().time();
 	const netlist_time delta = now - m_last_step;
@@ -282,7 +253,14 @@ ATTR_HOT nl_double matrix_solver_t::solve()
 	// We are already up to date. Avoid oscillations.
 	// FIXME: Make this a parameter!
 	if (delta < netlist_time::from_nsec(1)) // 20000
-		return -1.0;
+	{
+		m_solved = false;
+		return;
+	}
+
+#if !(PSTANDALONE)
+	const osd_ticks_t start = m_params.m_log_stats ? osd_ticks() : 0;
+#endif
 
 	/* update all terminals for new time step */
 	m_last_step = now;
@@ -290,10 +268,39 @@ ATTR_HOT nl_double matrix_solver_t::solve()
 
 	step(delta);
 
-	const nl_double next_time_step = vsolve();
+	m_next_ts = vsolve();
+	m_solved = true;
+
+#if !(PSTANDALONE)
+	if (m_params.m_log_stats)
+		m_stat_solve_ticks += osd_ticks() - start;
+#endif
+}
+
+ATTR_HOT nl_double matrix_solver_t::solve_finish()
+{
+	if (!m_solved)
+		return -1.0;
+	m_solved = false;
+
+	if (m_resched_pending)
+	{
+		m_resched_pending = false;
+		if (!m_Q_sync.net().is_queued())
+		{
+			log().warning("NEWTON_LOOPS exceeded on net {1}... reschedule", this->name());
+			m_Q_sync.net().reschedule_in_queue(m_params.m_nt_sync_delay);
+		}
+	}
 
 	update_inputs();
-	return next_time_step;
+	return m_next_ts;
+}
+
+ATTR_HOT nl_double matrix_solver_t::solve()
+{
+	solve_compute();
+	return solve_finish();
 }
 
 ATTR_COLD int matrix_solver_t::get_net_idx(net_t *net)
@@ -321,6 +328,44 @@ void matrix_solver_t::log_stats()
 				100.0 * (double) this->m_iterative_fail / (double) this->m_stat_calculations,
 				(double) this->m_iterative_total / (double) this->m_stat_calculations);
 	}
+#if !(PSTANDALONE)
+	if (this->m_stat_vsolver_calls != 0 && this->m_params.m_log_stats)
+		log().verbose("Solver {1}: {2:10.6} s solving ({3:8.3} us per call)", this->name(),
+				(double) this->m_stat_solve_ticks / (double) osd_ticks_per_second(),
+				(double) this->m_stat_solve_ticks * 1e6 / (double) osd_ticks_per_second() / (double) this->m_stat_vsolver_calls);
+#endif
+}
+
+void matrix_solver_t::create_solver_code(postream &strm)
+{
+	strm.writeline(pfmt("// {1}: no static code for this solver type")(this->name()));
+}
+
+// ----------------------------------------------------------------------------------------
+// static_solver_list_t
+// ----------------------------------------------------------------------------------------
+
+static_solver_list_t *static_solver_list_t::s_first = NULL;
+
+void static_solver_list_t::register_list()
+{
+	/* every machine using the netlist includes it again */
+	if (m_registered)
+		return;
+	m_next = s_first;
+	s_first = this;
+	m_registered = true;
+}
+
+static_solver_fp static_solver_list_t::find(const pstring &name)
+{
+	if (name == "")
+		return NULL;
+	for (const static_solver_list_t *l = s_first; l != NULL; l = l->m_next)
+		for (unsigned i = 0; i < l->m_count; i++)
+			if (name == l->m_list[i].m_name)
+				return l->m_list[i].m_func;
+	return NULL;
 }
 
 
@@ -355,7 +400,8 @@ NETLIB_START(solver)
 	register_param("GMIN", m_gmin, NETLIST_GMIN_DEFAULT);
 	register_param("PIVOT", m_pivot, 0);                    // use pivoting - on supported solvers
 	register_param("NR_LOOPS", m_nr_loops, 250);            // Newton-Raphson loops
-	register_param("PARALLEL", m_parallel, 0);
+	register_param("PARALLEL", m_parallel, 0);              // solve time step solvers on worker threads
+	register_param("PARALLEL_THRESHOLD", m_parallel_threshold, 8); // smaller solvers stay on the netlist thread
 
 	/* automatic time step */
 	register_param("DYNAMIC_TS", m_dynamic, 0);
@@ -387,53 +433,71 @@ NETLIB_STOP(solver)
 {
 	for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
 		m_mat_solvers[i]->log_stats();
+	if (m_parallel_solvers.size() > 0 && m_params.m_log_stats)
+		netlist().log().verbose("{1} solvers solved in parallel, {2} serially", (unsigned) m_parallel_solvers.size(), (unsigned) m_serial_solvers.size());
 }
 
 NETLIB_NAME(solver)::~NETLIB_NAME(solver)()
 {
+#if !(PSTANDALONE)
+	if (m_queue != NULL)
+		osd_work_queue_free(m_queue);
+#endif
 	m_mat_solvers.clear_and_free();
 }
 
+#if !(PSTANDALONE)
+void *NETLIB_NAME(solver)::solve_callback(void *param, int threadid)
+{
+	matrix_solver_t *ms = *(matrix_solver_t **) param;
+	ms->solve_compute();
+	return NULL;
+}
+#endif
+
 NETLIB_UPDATE(solver)
 {
 	if (m_params.m_dynamic)
 		return;
 
-	const std::size_t t_cnt = m_mat_solvers.size();
-
-#if HAS_OPENMP && USE_OPENMP
-	if (m_parallel.Value())
+#if !(PSTANDALONE)
+	if (m_queue != NULL)
 	{
-		omp_set_num_threads(3);
-		//omp_set_dynamic(0);
-		#pragma omp parallel
-		{
-			#pragma omp for
-			for (int i = 0; i <  t_cnt; i++)
-				if (m_mat_solvers[i]->is_timestep())
-				{
-					// Ignore return value
-					ATTR_UNUSED const nl_double ts = m_mat_solvers[i]->solve();
-				}
-		}
+		/* hand the large solvers to the workers and do the small ones meanwhile.
+		 *
+		 * Every solver computes its step before any of them updates its
+		 * inputs, so a device in one solver which reads a net of another
+		 * solver (through the proxy outputs set in update_inputs) sees the
+		 * value of the previous time step. The serial loop below already
+		 * behaves like this when the reading solver comes first in
+		 * m_mat_solvers; here it applies to all pairs.
+		 */
+		osd_work_item_queue_multiple(m_queue, solve_callback, m_parallel_solvers.size(),
+				m_parallel_solvers.data(), sizeof(matrix_solver_t *), WORK_ITEM_FLAG_AUTO_RELEASE);
+		for (std::size_t i = 0; i < m_serial_solvers.size(); i++)
+			m_serial_solvers[i]->solve_compute();
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 10);
+
+		/* inputs and queue updates are not thread safe */
+		for (std::size_t i = 0; i < m_parallel_solvers.size(); i++)
+			m_parallel_solvers[i]->solve_finish();
+		for (std::size_t i = 0; i < m_serial_solvers.size(); i++)
+			m_serial_solvers[i]->solve_finish();
 	}
 	else
-		for (int i = 0; i < t_cnt; i++)
+#endif
+	{
+		const std::size_t t_cnt = m_mat_solvers.size();
+
+		for (std::size_t i = 0; i < t_cnt; i++)
+		{
 			if (m_mat_solvers[i]->is_timestep())
 			{
 				// Ignore return value
 				ATTR_UNUSED const nl_double ts = m_mat_solvers[i]->solve();
 			}
-#else
-	for (std::size_t i = 0; i < t_cnt; i++)
-	{
-		if (m_mat_solvers[i]->is_timestep())
-		{
-			// Ignore return value
-			ATTR_UNUSED const nl_double ts = m_mat_solvers[i]->solve();
 		}
 	}
-#endif
 
 	/* step circuit */
 	if (!m_Q_step.net().is_queued())
@@ -482,6 +546,43 @@ matrix_solver_t * NETLIB_NAME(solver)::create_solver(int size, const bool use_sp
 	}
 }
 
+ATTR_COLD void NETLIB_NAME(solver)::create_solver_code(postream &strm, const pstring &name)
+{
+	plist_t<pstring> names;
+
+	strm.writeline("// Generated by nltool -c static, do not edit");
+	strm.writeline("");
+	strm.writeline("#include \"nl_setup.h\"");
+	strm.writeline("#include \"solver/nld_solver.h\"");
+	strm.writeline("");
+	for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
+	{
+		const pstring name = m_mat_solvers[i]->static_compile_name();
+		/* solvers with identical structure share the code */
+		if (name == "")
+			m_mat_solvers[i]->matrix_solver_t::create_solver_code(strm);
+		else if (!names.contains(name))
+		{
+			m_mat_solvers[i]->create_solver_code(strm);
+			names.add(name);
+		}
+		strm.writeline("");
+	}
+
+	strm.writeline("static const netlist::devices::static_solver_entry_t nl_static_solvers[] =");
+	strm.writeline("{");
+	for (std::size_t i = 0; i < names.size(); i++)
+		strm.writeline(pfmt("\t{ \"{1}\", &{2} },")(names[i])(names[i]));
+	strm.writeline("\t{ NULL, NULL }");
+	strm.writeline("};");
+	strm.writeline("");
+	strm.writeline(pfmt("static netlist::devices::static_solver_list_t nl_static_solver_list(nl_static_solvers, {1});")((unsigned) names.size()));
+	strm.writeline("");
+	strm.writeline(pfmt("NETLIST_START({1})")(name));
+	strm.writeline("\tnl_static_solver_list.register_list();");
+	strm.writeline("NETLIST_END()");
+}
+
 ATTR_COLD void NETLIB_NAME(solver)::post_start()
 {
 	analog_net_t::list_t groups[256];
@@ -638,6 +739,35 @@ ATTR_COLD void NETLIB_NAME(solver)::post_start()
 			}
 		}
 	}
+
+	/* fixed time step solvers are all solved at once in update() - spread
+	 * them over worker threads if there are at least two worth it
+	 */
+	m_parallel_solvers.clear();
+	m_serial_solvers.clear();
+	for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
+		if (m_mat_solvers[i]->is_timestep())
+		{
+			if (m_parallel.Value() && m_mat_solvers[i]->net_count() >= (std::size_t) m_parallel_threshold.Value())
+				m_parallel_solvers.add(m_mat_solvers[i]);
+			else
+				m_serial_solvers.add(m_mat_solvers[i]);
+		}
+
+#if !(PSTANDALONE)
+	if (!m_params.m_dynamic && m_parallel_solvers.size() + (m_serial_solvers.size() > 0 ? 1 : 0) >= 2)
+	{
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+		netlist().log().verbose("Solving {1} of {2} time step solvers in parallel", (unsigned) m_parallel_solvers.size(),
+				(unsigned) (m_parallel_solvers.size() + m_serial_solvers.size()));
+	}
+	else
+#endif
+	{
+		/* everything runs through m_mat_solvers */
+		m_parallel_solvers.clear();
+		m_serial_solvers.clear();
+	}
 }
 
 NETLIB_NAMESPACE_DEVICES_END()
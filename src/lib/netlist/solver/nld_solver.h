@@ -10,6 +10,7 @@
 
 #include "nl_setup.h"
 #include "nl_base.h"
+#include "plib/pstream.h"
 
 //#define ATTR_ALIGNED(N) __attribute__((aligned(N)))
 #define ATTR_ALIGNED(N) ATTR_ALIGN
@@ -93,6 +94,45 @@ private:
 	plist_t<nl_double *> m_other_curanalog;
 };
 
+/* Solvers compiled from a netlist by "nltool -c static". The generated
+ * source contains a netlist (static_solvers, or static_solvers_<name>
+ * with -n) which registers its functions here; a driver netlist pulls
+ * them in with LOCAL_SOURCE() and INCLUDE() like any other netlist
+ * source, so the linker cannot drop them. A direct (Gaussian elimination)
+ * solver whose matrix structure has the same name picks them up in
+ * vsetup() and no longer walks the sparsity lists at run time.
+ */
+
+typedef void (*static_solver_fp)(nl_double * RESTRICT A, nl_double * RESTRICT RHS,
+		nl_double * RESTRICT lu_f, nl_double * RESTRICT V);
+
+struct static_solver_entry_t
+{
+	const char *m_name;
+	static_solver_fp m_func;
+};
+
+class static_solver_list_t
+{
+	P_PREVENT_COPYING(static_solver_list_t)
+public:
+	static_solver_list_t(const static_solver_entry_t *list, const unsigned count)
+	: m_list(list), m_count(count), m_next(NULL), m_registered(false)
+	{
+	}
+
+	void register_list();
+	static static_solver_fp find(const pstring &name);
+
+private:
+	const static_solver_entry_t *m_list;
+	const unsigned m_count;
+	static_solver_list_t *m_next;
+	bool m_registered;
+
+	static static_solver_list_t *s_first;
+};
+
 class matrix_solver_t : public device_t
 {
 public:
@@ -115,6 +155,13 @@ public:
 
 	ATTR_HOT nl_double solve();
 
+	/* solve() split in two: the first half only touches the solver's own
+	 * nets and devices and may run on a worker thread, the second half
+	 * updates inputs and the queue and has to run on the netlist thread.
+	 */
+	ATTR_HOT void solve_compute();
+	ATTR_HOT nl_double solve_finish();
+
 	ATTR_HOT inline bool is_dynamic() { return m_dynamic_devices.size() > 0; }
 	ATTR_HOT inline bool is_timestep() { return m_step_devices.size() > 0; }
 
@@ -130,12 +177,17 @@ public:
 	virtual void reset() override;
 
 	ATTR_COLD int get_net_idx(net_t *net);
+	inline std::size_t net_count() const { return m_nets.size(); }
 
 	inline eSolverType type() const { return m_type; }
 	plog_base<NL_DEBUG> &log() { return netlist().log(); }
 
 	virtual void log_stats();
 
+	/* static code generation, empty name if the solver type has none */
+	virtual pstring static_compile_name() { return ""; }
+	virtual void create_solver_code(postream &strm);
+
 protected:
 
 	ATTR_COLD void setup(analog_net_t::list_t &nets);
@@ -154,6 +206,7 @@ protected:
 	int m_stat_vsolver_calls;
 	int m_iterative_fail;
 	int m_iterative_total;
+	UINT64 m_stat_solve_ticks;
 
 	const solver_parameters_t &m_params;
 
@@ -162,6 +215,9 @@ private:
 
 	netlist_time m_last_step;
 	nl_double m_cur_ts;
+	nl_double m_next_ts;
+	bool m_solved;
+	bool m_resched_pending;
 	dev_list_t m_step_devices;
 	dev_list_t m_dynamic_devices;
 
@@ -177,11 +233,42 @@ private:
 
 
 
+template<class C >
+void matrix_solver_t::solve_base(C *p)
+{
+	m_stat_vsolver_calls++;
+	if (is_dynamic())
+	{
+		int this_resched;
+		int newton_loops = 0;
+		do
+		{
+			update_dynamic();
+			// Gauss-Seidel will revert to Gaussian elemination if steps exceeded.
+			this_resched = p->vsolve_non_dynamic(true);
+			newton_loops++;
+		} while (this_resched > 1 && newton_loops < m_params.m_nr_loops);
+
+		m_stat_newton_raphson += newton_loops;
+		// reschedule .... (done in solve_finish, we may be on a worker thread)
+		if (this_resched > 1)
+			m_resched_pending = true;
+	}
+	else
+	{
+		p->vsolve_non_dynamic(false);
+	}
+}
+
 class NETLIB_NAME(solver) : public device_t
 {
 public:
 	NETLIB_NAME(solver)()
-	: device_t()    { }
+	: device_t()
+#if !(PSTANDALONE)
+	, m_queue(NULL)
+#endif
+	{ }
 
 	virtual ~NETLIB_NAME(solver)();
 
@@ -190,6 +277,8 @@ public:
 
 	ATTR_HOT inline nl_double gmin() { return m_gmin.Value(); }
 
+	ATTR_COLD void create_solver_code(postream &strm, const pstring &name);
+
 protected:
 	ATTR_HOT void update() override;
 	ATTR_HOT void start() override;
@@ -214,6 +303,7 @@ protected:
 	param_int_t m_gs_loops;
 	param_int_t m_gs_threshold;
 	param_int_t m_parallel;
+	param_int_t m_parallel_threshold;
 
 	param_logic_t  m_log_stats;
 
@@ -222,6 +312,14 @@ private:
 
 	solver_parameters_t m_params;
 
+	/* time step solvers large enough to be solved on worker threads, and the rest */
+	matrix_solver_t::list_t m_parallel_solvers;
+	matrix_solver_t::list_t m_serial_solvers;
+#if !(PSTANDALONE)
+	osd_work_queue *m_queue;
+	static void *solve_callback(void *param, int threadid);
+#endif
+
 	template <int m_N, int _storage_N>
 	matrix_solver_t *create_solver(int size, bool use_specific);
 };
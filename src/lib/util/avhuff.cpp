@@ -67,6 +67,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <new>
+#include <algorithm>
 
 
 
@@ -967,17 +968,20 @@ avhuff_error avhuff_decoder::decode_audio(int channels, int samples, const UINT8
 			else
 			{
 				bitstream_in bitbuf(source, size);
-				for (int sampnum = 0; sampnum < samples; sampnum++)
+				UINT16 deltas[256];
+				for (int sampbase = 0; sampbase < samples; sampbase += ARRAY_LENGTH(deltas))
 				{
-					INT16 delta = m_audiohi_decoder.decode_one(bitbuf) << 8;
-					delta |= m_audiolo_decoder.decode_one(bitbuf);
-
-					INT16 newsample = prevsample + delta;
-					prevsample = newsample;
-
-					curdest[0 ^ dxor] = newsample >> 8;
-					curdest[1 ^ dxor] = newsample;
-					curdest += 2;
+					int count = std::min(samples - sampbase, int(ARRAY_LENGTH(deltas)));
+					m_audiohi_decoder.decode_pairs(bitbuf, m_audiolo_decoder, deltas, count);
+					for (int sampnum = 0; sampnum < count; sampnum++)
+					{
+						INT16 newsample = prevsample + deltas[sampnum];
+						prevsample = newsample;
+
+						curdest[0 ^ dxor] = newsample >> 8;
+						curdest[1 ^ dxor] = newsample;
+						curdest += 2;
+					}
 				}
 				if (bitbuf.overflow())
 					return AVHERR_INVALID_DATA;
@@ -1056,7 +1060,8 @@ avhuff_error avhuff_decoder::decode_video_lossless(int width, int height, const
 		return AVHERR_INVALID_DATA;
 	bitbuf.flush();
 
-	// decode to the destination
+	// decode to the destination; a context with RLE data pending reads no
+	// bits, so codes are taken one at a time rather than in pairs
 	m_ycontext.reset();
 	m_cbcontext.reset();
 	m_crcontext.reset();
@@ -39,7 +39,7 @@ public:
 
 private:
 	// internal state
-	UINT32          m_buffer;       // current bit accumulator
+	UINT64          m_buffer;       // current bit accumulator
 	int             m_bits;         // number of bits in the accumulator
 	const UINT8 *   m_read;         // read pointer
 	UINT32          m_doffset;      // byte offset within the data
@@ -103,17 +103,32 @@ inline UINT32 bitstream_in::peek(int numbits)
 	// fetch data if we need more
 	if (numbits > m_bits)
 	{
-		while (m_bits <= 24)
+		// away from the end, load 8 bytes at once; bits past the whole bytes
+		// we keep are the same ones the next refill ORs in again
+		if (m_doffset + 8 <= m_dlength)
 		{
-			if (m_doffset < m_dlength)
-				m_buffer |= m_read[m_doffset] << (24 - m_bits);
-			m_doffset++;
-			m_bits += 8;
+			const UINT8 *src = m_read + m_doffset;
+			UINT64 data = ((UINT64)src[0] << 56) | ((UINT64)src[1] << 48) | ((UINT64)src[2] << 40) | ((UINT64)src[3] << 32) |
+					((UINT64)src[4] << 24) | ((UINT64)src[5] << 16) | ((UINT64)src[6] << 8) | (UINT64)src[7];
+			m_buffer |= data >> m_bits;
+			int bytes = (63 - m_bits) >> 3;
+			m_doffset += bytes;
+			m_bits += bytes * 8;
+		}
+		else
+		{
+			while (m_bits <= 56)
+			{
+				if (m_doffset < m_dlength)
+					m_buffer |= UINT64(m_read[m_doffset]) << (56 - m_bits);
+				m_doffset++;
+				m_bits += 8;
+			}
 		}
 	}
 
 	// return the data
-	return m_buffer >> (32 - numbits);
+	return m_buffer >> (64 - numbits);
 }
 
 
@@ -189,7 +189,16 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
 
+	// copy from the mapping if we can; it needs no locking
+	const UINT8 *mapped = file_mapped(offset, length);
+	if (mapped != nullptr)
+	{
+		memcpy(dest, mapped, length);
+		return;
+	}
+
 	// seek and read
+	std::lock_guard<std::mutex> lock(m_file_lock);
 	core_fseek(m_file, offset, SEEK_SET);
 	UINT32 count = core_fread(m_file, dest, length);
 	if (count != length)
@@ -197,6 +206,36 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 }
 
 
+//-------------------------------------------------
+//  file_mapped - return a pointer to data in the
+//  file mapping, or nullptr if the range isn't
+//  mapped
+//-------------------------------------------------
+
+inline const UINT8 *chd_file::file_mapped(UINT64 offset, UINT32 length)
+{
+	if (m_mapped == nullptr || offset > m_mapped_length || length > m_mapped_length - offset)
+		return nullptr;
+	return m_mapped + offset;
+}
+
+
+//-------------------------------------------------
+//  file_read_mapped - return a pointer to file
+//  data, pointing into the mapping if possible
+//  and reading into the given buffer otherwise
+//-------------------------------------------------
+
+inline const UINT8 *chd_file::file_read_mapped(UINT64 offset, UINT32 length, dynamic_buffer &buffer)
+{
+	const UINT8 *mapped = file_mapped(offset, length);
+	if (mapped != nullptr)
+		return mapped;
+	file_read(offset, &buffer[0], length);
+	return &buffer[0];
+}
+
+
 //-------------------------------------------------
 //  file_write - write to the file at the given
 //  offset; on failure throw an error
@@ -209,6 +248,7 @@ inline void chd_file::file_write(UINT64 offset, const void *source, UINT32 lengt
 		throw CHDERR_NOT_OPEN;
 
 	// seek and write
+	std::lock_guard<std::mutex> lock(m_file_lock);
 	core_fseek(m_file, offset, SEEK_SET);
 	UINT32 count = core_fwrite(m_file, source, length);
 	if (count != length)
@@ -229,6 +269,7 @@ inline UINT64 chd_file::file_append(const void *source, UINT32 length, UINT32 al
 		throw CHDERR_NOT_OPEN;
 
 	// seek to the end and align if necessary
+	std::lock_guard<std::mutex> lock(m_file_lock);
 	core_fseek(m_file, 0, SEEK_END);
 	if (alignment != 0)
 	{
@@ -289,10 +330,15 @@ inline UINT8 chd_file::bits_for_value(UINT64 value)
 
 chd_file::chd_file()
 	: m_file(nullptr),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_mapped(nullptr),
+		m_cache_hunks(DEFAULT_CACHE_HUNKS),
+		m_readahead(DEFAULT_READAHEAD_HUNKS),
+		m_readahead_queue(nullptr)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
+	memset(m_async_decompressor, 0, sizeof(m_async_decompressor));
 	close();
 }
 
@@ -795,6 +841,20 @@ chd_error chd_file::open(core_file &file, bool writeable, chd_file *parent)
 
 void chd_file::close()
 {
+	// stop any read ahead before the file goes away
+	cache_reset();
+	if (m_readahead_queue != nullptr)
+		osd_work_queue_free(m_readahead_queue);
+	m_readahead_queue = nullptr;
+	for (auto & thread : m_async_decompressor)
+		for (auto & elem : thread)
+		{
+			delete elem;
+			elem = nullptr;
+		}
+	for (auto & elem : m_async_compressed)
+		elem.clear();
+
 	// reset file characteristics
 	if (m_owns_file && m_file != nullptr)
 		core_fclose(m_file);
@@ -802,6 +862,8 @@ void chd_file::close()
 	m_owns_file = false;
 	m_allow_reads = false;
 	m_allow_writes = false;
+	m_mapped = nullptr;
+	m_mapped_length = 0;
 
 	// reset core parameters from the header
 	m_version = HEADER_VERSION;
@@ -835,9 +897,9 @@ void chd_file::close()
 	}
 	m_compressed.clear();
 
-	// reset caching
+	// reset caching; the cache size is kept across files
 	m_cache.clear();
-	m_cachehunk = ~0;
+	m_cacheable = false;
 }
 
 /**
@@ -864,6 +926,68 @@ void chd_file::close()
  */
 
 chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
+{
+	// punt if no file
+	if (m_file == nullptr)
+		return CHDERR_NOT_OPEN;
+
+	// return an error if out of range
+	if (hunknum >= m_hunkcount)
+		return CHDERR_HUNK_OUT_OF_RANGE;
+
+	// hunks stored raw in a mapped file are copied straight from the mapping
+	chd_error err = CHDERR_NONE;
+	const UINT8 *mapped = (buffer != nullptr) ? mapped_hunk(hunknum) : nullptr;
+	if (mapped != nullptr)
+	{
+		memcpy(buffer, mapped, m_hunkbytes);
+		cache_note_access(hunknum, nullptr);
+	}
+
+	// go through the cache like partial reads do, so a hunk read again soon
+	// is not decompressed twice; codecs configured per read bypass it
+	else if (buffer != nullptr && m_cacheable)
+	{
+		const UINT8 *cached = cache_hunk(hunknum, err);
+		if (cached != nullptr)
+			memcpy(buffer, cached, m_hunkbytes);
+	}
+
+	// otherwise read it directly into the caller's buffer
+	else
+	{
+		m_cache_misses++;
+		err = read_hunk_uncached(hunknum, buffer);
+		if (err == CHDERR_NONE)
+			cache_note_access(hunknum, nullptr);
+	}
+	return err;
+}
+
+/**
+ * @fn  chd_error chd_file::read_hunk_uncached(UINT32 hunknum, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunk_uncached - read a single hunk from the CHD file, bypassing the cache
+ *          -------------------------------------------------.
+ *
+ * @exception   CHDERR_NOT_OPEN             Thrown when a chderr not open error condition occurs.
+ * @exception   CHDERR_HUNK_OUT_OF_RANGE    Thrown when a chderr hunk out of range error
+ *                                          condition occurs.
+ * @exception   CHDERR_DECOMPRESSION_ERROR  Thrown when a chderr decompression error error
+ *                                          condition occurs.
+ * @exception   CHDERR_REQUIRES_PARENT      Thrown when a chderr requires parent error condition
+ *                                          occurs.
+ * @exception   CHDERR_READ_ERROR           Thrown when a chderr read error error condition
+ *                                          occurs.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  buffer  If non-null, the buffer.
+ *
+ * @return  The hunk.
+ */
+
+chd_error chd_file::read_hunk_uncached(UINT32 hunknum, void *buffer)
 {
 	// wrap this for clean reporting
 	try
@@ -881,6 +1005,7 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 		UINT32 blocklen;
 		UINT32 blockcrc;
 		UINT8 *rawmap;
+		const UINT8 *compdata;
 		UINT8 *dest = reinterpret_cast<UINT8 *>(buffer);
 		switch (m_version)
 		{
@@ -894,8 +1019,8 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 				{
 					case V34_MAP_ENTRY_TYPE_COMPRESSED:
 						blocklen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
-						file_read(blockoffs, &m_compressed[0], blocklen);
-						m_decompressor[0]->decompress(&m_compressed[0], blocklen, dest, m_hunkbytes);
+						compdata = file_read_mapped(blockoffs, blocklen, m_compressed);
+						m_decompressor[0]->decompress(compdata, blocklen, dest, m_hunkbytes);
 						if (!(rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC) && dest != nullptr && crc32_creator::simple(dest, m_hunkbytes) != blockcrc)
 							throw CHDERR_DECOMPRESSION_ERROR;
 						return CHDERR_NONE;
@@ -915,7 +1040,7 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 						return CHDERR_NONE;
 
 					case V34_MAP_ENTRY_TYPE_SELF_HUNK:
-						return read_hunk(blockoffs, dest);
+						return read_hunk_uncached(blockoffs, dest);
 
 					case V34_MAP_ENTRY_TYPE_PARENT_HUNK:
 						if (m_parent_missing)
@@ -953,11 +1078,11 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 					case COMPRESSION_TYPE_1:
 					case COMPRESSION_TYPE_2:
 					case COMPRESSION_TYPE_3:
-						file_read(blockoffs, &m_compressed[0], blocklen);
-						m_decompressor[rawmap[0]]->decompress(&m_compressed[0], blocklen, dest, m_hunkbytes);
+						compdata = file_read_mapped(blockoffs, blocklen, m_compressed);
+						m_decompressor[rawmap[0]]->decompress(compdata, blocklen, dest, m_hunkbytes);
 						if (!m_decompressor[rawmap[0]]->lossy() && dest != nullptr && crc16_creator::simple(dest, m_hunkbytes) != blockcrc)
 							throw CHDERR_DECOMPRESSION_ERROR;
-						if (m_decompressor[rawmap[0]]->lossy() && crc16_creator::simple(&m_compressed[0], blocklen) != blockcrc)
+						if (m_decompressor[rawmap[0]]->lossy() && crc16_creator::simple(compdata, blocklen) != blockcrc)
 							throw CHDERR_DECOMPRESSION_ERROR;
 						return CHDERR_NONE;
 
@@ -968,7 +1093,7 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 						return CHDERR_NONE;
 
 					case COMPRESSION_SELF:
-						return read_hunk(blockoffs, dest);
+						return read_hunk_uncached(blockoffs, dest);
 
 					case COMPRESSION_PARENT:
 						if (m_parent_missing)
@@ -989,6 +1114,113 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 	}
 }
 
+/**
+ * @fn  chd_error chd_file::read_compressed_hunk(UINT32 hunknum, dynamic_buffer &buffer, UINT32 &complen, chd_codec_type &codec)
+ *
+ * @brief   -------------------------------------------------
+ *            read_compressed_hunk - read the compressed data for a hunk without decompressing
+ *            it, following references to other hunks in the same file. Unlike read_hunk this
+ *            may be called from any thread while the file is open for reading only, so that
+ *            callers with their own codec instances can decompress hunks in parallel
+ *          -------------------------------------------------.
+ *
+ * @exception   CHDERR_NOT_OPEN             Thrown when a chderr not open error condition occurs.
+ * @exception   CHDERR_HUNK_OUT_OF_RANGE    Thrown when a chderr hunk out of range error
+ *                                          condition occurs.
+ * @exception   CHDERR_NOT_SUPPORTED        Thrown when the hunk isn't stored compressed in
+ *                                          this file, or the file is writeable.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  buffer  Receives the compressed data; resized as needed.
+ * @param [out] complen     Receives the length of the compressed data.
+ * @param [out] codec       Receives the codec the data was compressed with.
+ *
+ * @return  A chd_error. The data is not checked against the hunk CRC, which covers the
+ *          decompressed data.
+ */
+
+chd_error chd_file::read_compressed_hunk(UINT32 hunknum, dynamic_buffer &buffer, UINT32 &complen, chd_codec_type &codec)
+{
+	// wrap this for clean reporting
+	try
+	{
+		// punt if no file
+		if (m_file == nullptr)
+			throw CHDERR_NOT_OPEN;
+
+		// the map can change under us while writing
+		if (m_allow_writes || !compressed())
+			throw CHDERR_NOT_SUPPORTED;
+
+		// follow self references until we find the data; a chain longer than the file is broken
+		for (UINT32 hops = 0; hops < m_hunkcount; hops++)
+		{
+			// return an error if out of range
+			if (hunknum >= m_hunkcount)
+				throw CHDERR_HUNK_OUT_OF_RANGE;
+
+			UINT64 blockoffs;
+			const UINT8 *rawmap;
+			int codecnum = -1;
+			if (m_version < 5)
+			{
+				rawmap = &m_rawmap[16 * hunknum];
+				blockoffs = be_read(&rawmap[0], 8);
+				switch (rawmap[15] & V34_MAP_ENTRY_FLAG_TYPE_MASK)
+				{
+					case V34_MAP_ENTRY_TYPE_COMPRESSED:
+						complen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
+						codecnum = 0;
+						break;
+
+					case V34_MAP_ENTRY_TYPE_SELF_HUNK:
+						hunknum = blockoffs;
+						continue;
+
+					default:
+						throw CHDERR_NOT_SUPPORTED;
+				}
+			}
+			else
+			{
+				rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+				blockoffs = be_read(&rawmap[4], 6);
+				switch (rawmap[0])
+				{
+					case COMPRESSION_TYPE_0:
+					case COMPRESSION_TYPE_1:
+					case COMPRESSION_TYPE_2:
+					case COMPRESSION_TYPE_3:
+						complen = be_read(&rawmap[1], 3);
+						codecnum = rawmap[0];
+						break;
+
+					case COMPRESSION_SELF:
+						hunknum = blockoffs;
+						continue;
+
+					default:
+						throw CHDERR_NOT_SUPPORTED;
+				}
+			}
+
+			// file_read locks against other readers, and copies from the mapping if there is one
+			codec = m_compression[codecnum];
+			if (buffer.size() < complen)
+				buffer.resize(complen);
+			file_read(blockoffs, &buffer[0], complen);
+			return CHDERR_NONE;
+		}
+		throw CHDERR_READ_ERROR;
+	}
+
+	// just return errors
+	catch (chd_error &err)
+	{
+		return err;
+	}
+}
+
 /**
  * @fn  chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
  *
@@ -1029,6 +1261,11 @@ chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
 		if (compressed())
 			throw CHDERR_FILE_NOT_WRITEABLE;
 
+		// keep any cached copy of the hunk up to date
+		cache_entry *entry = cache_find(hunknum);
+		if (entry != nullptr && buffer != &entry->m_data[0])
+			memcpy(&entry->m_data[0], buffer, m_hunkbytes);
+
 		// see if we have allocated the space on disk for this hunk
 		UINT8 *rawmap = &m_rawmap[hunknum * 4];
 		UINT32 rawentry = be_read(rawmap, 4);
@@ -1056,10 +1293,6 @@ chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
 			// write the map entry back
 			be_write(rawmap, rawentry, 4);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
-
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != &m_cache[0])
-				memcpy(&m_cache[0], buffer, m_hunkbytes);
 		}
 
 		// otherwise, just overwrite
@@ -1140,22 +1373,23 @@ chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
+		// if it's a full block, just read it; read_hunk checks the mapping and the cache
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		const UINT8 *mapped;
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1)
 			err = read_hunk(curhunk, dest);
 
+		// partial hunks stored raw in a mapped file need no cache entry
+		else if ((mapped = mapped_hunk(curhunk)) != nullptr)
+			memcpy(dest, &mapped[startoffs], endoffs + 1 - startoffs);
+
 		// otherwise, read from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
+			UINT8 *cached = cache_hunk(curhunk, err);
+			if (cached == nullptr)
+				return err;
+			memcpy(dest, &cached[startoffs], endoffs + 1 - startoffs);
 		}
 
 		// handle errors and advance
@@ -1166,6 +1400,70 @@ chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
 	return CHDERR_NONE;
 }
 
+/**
+ * @fn  const UINT8 *chd_file::mapped_hunk(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            mapped_hunk - return a pointer to a hunk that is stored uncompressed and
+ *            without a CRC in a mapped file, following parent and self references; the
+ *            data can be used without copying until the file is closed
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  null if the hunk has to be read with read_hunk, else a pointer to its data.
+ */
+
+const UINT8 *chd_file::mapped_hunk(UINT32 hunknum)
+{
+	if (m_file == nullptr || hunknum >= m_hunkcount || (m_mapped == nullptr && m_parent == nullptr))
+		return nullptr;
+
+	const UINT8 *rawmap;
+	UINT64 blockoffs;
+	switch (m_version)
+	{
+		// v3/v4 map entries; uncompressed hunks normally have a CRC, which we'd have to check
+		case 3:
+		case 4:
+			rawmap = &m_rawmap[16 * hunknum];
+			blockoffs = be_read(&rawmap[0], 8);
+			switch (rawmap[15] & V34_MAP_ENTRY_FLAG_TYPE_MASK)
+			{
+				case V34_MAP_ENTRY_TYPE_UNCOMPRESSED:
+					if (rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC)
+						return file_mapped(blockoffs, m_hunkbytes);
+					break;
+
+				case V34_MAP_ENTRY_TYPE_SELF_HUNK:
+					return mapped_hunk(blockoffs);
+
+				case V34_MAP_ENTRY_TYPE_PARENT_HUNK:
+					if (m_parent != nullptr && !m_parent_missing)
+						return m_parent->mapped_hunk(blockoffs);
+					break;
+			}
+			break;
+
+		// v5 map entries; only uncompressed files store raw hunks without a CRC
+		case 5:
+			if (compressed())
+			{
+				rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+				if (rawmap[0] == COMPRESSION_SELF)
+					return mapped_hunk(be_read(&rawmap[4], 6));
+				break;
+			}
+			blockoffs = UINT64(be_read(&m_rawmap[m_mapentrybytes * hunknum], 4)) * UINT64(m_hunkbytes);
+			if (blockoffs != 0)
+				return file_mapped(blockoffs, m_hunkbytes);
+			if (m_parent != nullptr && !m_parent_missing)
+				return m_parent->mapped_hunk(hunknum);
+			break;
+	}
+	return nullptr;
+}
+
 /**
  * @fn  chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
  *
@@ -1193,23 +1491,19 @@ chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just write directly to disk unless it's the cached hunk
+		// if it's a full block, just write directly to disk; write_hunk updates the cache
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1)
 			err = write_hunk(curhunk, source);
 
 		// otherwise, write from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
-			err = write_hunk(curhunk, &m_cache[0]);
+			UINT8 *cached = cache_hunk(curhunk, err);
+			if (cached == nullptr)
+				return err;
+			memcpy(&cached[startoffs], source, endoffs + 1 - startoffs);
+			err = write_hunk(curhunk, cached);
 		}
 
 		// handle errors and advance
@@ -1220,6 +1514,33 @@ chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
 	return CHDERR_NONE;
 }
 
+/**
+ * @fn  void chd_file::set_cache_size(UINT32 hunks, UINT32 readahead)
+ *
+ * @brief   -------------------------------------------------
+ *            set_cache_size - set the number of decompressed hunks to keep around, and how many
+ *            hunks to decompress ahead on other threads once reads are seen to be sequential
+ *          -------------------------------------------------.
+ *
+ * @param   hunks       The number of hunks to cache; at least one is always kept.
+ * @param   readahead   The number of hunks to read ahead; 0 to disable.
+ */
+
+void chd_file::set_cache_size(UINT32 hunks, UINT32 readahead)
+{
+	// flush whatever is there, including pending reads
+	cache_reset();
+
+	// read ahead needs somewhere to go without evicting the hunk in use
+	m_cache_hunks = MAX(hunks, 1);
+	m_readahead = MIN(readahead, m_cache_hunks - 1);
+	if (m_file != nullptr)
+	{
+		m_cache.clear();
+		m_cache.resize(m_cache_hunks);
+	}
+}
+
 /**
  * @fn  chd_error chd_file::read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, std::string &output)
  *
@@ -2420,6 +2741,13 @@ chd_error chd_file::open_common(bool writeable)
 		else if (m_parent != nullptr)
 			throw CHDERR_INVALID_PARAMETER;
 
+		// map the file, so that uncompressed hunks can be served straight from the page
+		// cache; writes show through the mapping, and anything appended after this point
+		// (or everything, if the OSD can't map files) is read through the file instead
+		m_mapped = reinterpret_cast<const UINT8 *>(core_fmap(m_file));
+		if (m_mapped != nullptr)
+			m_mapped_length = core_fsize(m_file);
+
 		// finish opening the file
 		create_open_common();
 		return CHDERR_NONE;
@@ -2461,9 +2789,15 @@ void chd_file::create_open_common()
 	else
 		file_read(m_mapoffset, &m_rawmap[0], m_rawmap.size());
 
-	// allocate the temporary compressed buffer and a buffer for caching
+	// allocate the temporary compressed buffer and the cache; A/V codecs are configured
+	// per read, so their hunks can't be served from the cache
 	m_compressed.resize(m_hunkbytes);
-	m_cache.resize(m_hunkbytes);
+	m_cache.clear();
+	m_cache.resize(m_cache_hunks);
+	m_cacheable = true;
+	for (auto & elem : m_compression)
+		if (elem == CHD_CODEC_AVHUFF)
+			m_cacheable = false;
 }
 
 /**
@@ -2600,6 +2934,361 @@ void chd_file::hunk_copy_from_parent(UINT32 hunknum, UINT64 parentunit)
 	be_write(&rawmap[10], 0, 2);
 }
 
+/**
+ * @fn  chd_file::cache_entry *chd_file::cache_find(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_find - find a hunk in the cache, waiting for it if it is still being read
+ *            ahead
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  null if the hunk isn't cached, else the cache entry.
+ */
+
+chd_file::cache_entry *chd_file::cache_find(UINT32 hunknum)
+{
+	for (auto & entry : m_cache)
+		if (entry.m_hunknum == hunknum)
+		{
+			// wait for read ahead to finish; drop the entry if it failed
+			if (entry.m_osd != nullptr)
+				cache_wait(entry);
+			if (entry.m_error != CHDERR_NONE)
+			{
+				entry.m_hunknum = ~0;
+				entry.m_readahead = false;
+				return nullptr;
+			}
+			return &entry;
+		}
+	return nullptr;
+}
+
+/**
+ * @fn  chd_file::cache_entry *chd_file::cache_victim(const cache_entry *keep)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_victim - find the least recently used cache entry that isn't being read
+ *            ahead, and make it empty
+ *          -------------------------------------------------.
+ *
+ * @param   keep    An entry which must not be chosen, or null.
+ *
+ * @return  null if every entry is busy, else an empty entry with room for a hunk.
+ */
+
+chd_file::cache_entry *chd_file::cache_victim(const cache_entry *keep)
+{
+	cache_entry *victim = nullptr;
+	for (auto & entry : m_cache)
+		if (&entry != keep && entry.m_osd == nullptr && (victim == nullptr || entry.m_lastuse < victim->m_lastuse))
+			victim = &entry;
+
+	if (victim != nullptr)
+	{
+		victim->m_hunknum = ~0;
+		victim->m_error = CHDERR_NONE;
+		victim->m_readahead = false;
+		victim->m_data.resize(m_hunkbytes);
+	}
+	return victim;
+}
+
+/**
+ * @fn  UINT8 *chd_file::cache_hunk(UINT32 hunknum, chd_error &err)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_hunk - return a pointer to the given hunk in the cache, reading it in if
+ *            necessary; used for partial reads and writes
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [out] err         Receives the error if the hunk couldn't be read.
+ *
+ * @return  null on error, else a pointer to the cached hunk.
+ */
+
+UINT8 *chd_file::cache_hunk(UINT32 hunknum, chd_error &err)
+{
+	// punt if no file
+	if (m_file == nullptr)
+	{
+		err = CHDERR_NOT_OPEN;
+		return nullptr;
+	}
+
+	cache_entry *entry = cache_find(hunknum);
+	if (entry != nullptr)
+	{
+		m_cache_hits++;
+		if (entry->m_readahead)
+			m_readahead_hits++;
+		entry->m_readahead = false;
+	}
+	else
+	{
+		// if read ahead owns every entry, let it finish so one can be reused
+		m_cache_misses++;
+		entry = cache_victim(nullptr);
+		if (entry == nullptr)
+		{
+			for (auto & elem : m_cache)
+				if (elem.m_osd != nullptr)
+					cache_wait(elem);
+			entry = cache_victim(nullptr);
+		}
+		err = read_hunk_uncached(hunknum, &entry->m_data[0]);
+		if (err != CHDERR_NONE)
+			return nullptr;
+		entry->m_hunknum = hunknum;
+	}
+
+	entry->m_lastuse = ++m_cacheclock;
+	cache_note_access(hunknum, entry);
+	err = CHDERR_NONE;
+	return &entry->m_data[0];
+}
+
+/**
+ * @fn  void chd_file::cache_note_access(UINT32 hunknum, const cache_entry *keep)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_note_access - track sequential access, and once it is established queue up
+ *            the following hunks to be decompressed on other threads
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum just accessed.
+ * @param   keep    The cache entry holding it, which must not be evicted, or null.
+ */
+
+void chd_file::cache_note_access(UINT32 hunknum, const cache_entry *keep)
+{
+	// repeated partial reads of the same hunk don't count either way
+	if (hunknum == m_lasthunk)
+		return;
+	m_sequential = (hunknum == m_lasthunk + 1) ? m_sequential + 1 : 0;
+	m_lasthunk = hunknum;
+	if (m_readahead == 0 || m_sequential < READAHEAD_TRIGGER)
+		return;
+
+	// queue up anything in the window that isn't already there
+	for (UINT32 nexthunk = hunknum + 1; nexthunk <= hunknum + m_readahead && nexthunk < m_hunkcount; nexthunk++)
+	{
+		bool present = false;
+		for (auto & entry : m_cache)
+			if (entry.m_hunknum == nexthunk)
+				present = true;
+		if (present || !readahead_possible(nexthunk))
+			continue;
+
+		// allocate the queue the first time we need it
+		if (m_readahead_queue == nullptr)
+		{
+			m_readahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+			if (m_readahead_queue == nullptr)
+			{
+				m_readahead = 0;
+				return;
+			}
+		}
+
+		// stop if everything else is already in flight
+		cache_entry *entry = cache_victim(keep);
+		if (entry == nullptr)
+			break;
+		entry->m_chd = this;
+		entry->m_hunknum = nexthunk;
+		entry->m_readahead = true;
+		entry->m_lastuse = ++m_cacheclock;
+		entry->m_osd = osd_work_item_queue(m_readahead_queue, async_read_hunk_static, entry, 0);
+		if (entry->m_osd == nullptr)
+		{
+			entry->m_hunknum = ~0;
+			entry->m_readahead = false;
+			break;
+		}
+	}
+}
+
+/**
+ * @fn  void chd_file::cache_wait(cache_entry &entry)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_wait - wait for a read ahead to finish and release its work item
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  entry   The entry being read ahead.
+ */
+
+void chd_file::cache_wait(cache_entry &entry)
+{
+	while (!osd_work_item_wait(entry.m_osd, osd_ticks_per_second()))
+		;
+	osd_work_item_release(entry.m_osd);
+	entry.m_osd = nullptr;
+}
+
+/**
+ * @fn  void chd_file::cache_reset()
+ *
+ * @brief   -------------------------------------------------
+ *            cache_reset - wait for any read ahead and empty the cache
+ *          -------------------------------------------------.
+ */
+
+void chd_file::cache_reset()
+{
+	for (auto & entry : m_cache)
+	{
+		if (entry.m_osd != nullptr)
+			cache_wait(entry);
+		entry.m_hunknum = ~0;
+		entry.m_lastuse = 0;
+		entry.m_error = CHDERR_NONE;
+		entry.m_readahead = false;
+	}
+	m_cacheclock = 0;
+	m_cache_hits = 0;
+	m_cache_misses = 0;
+	m_readahead_hits = 0;
+	m_lasthunk = ~0;
+	m_sequential = 0;
+}
+
+/**
+ * @fn  bool chd_file::readahead_possible(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_possible - can the given hunk be read ahead? Only hunks that are read
+ *            from the file and decompressed are worth doing on another thread, and nothing
+ *            else may touch the file or the map meanwhile
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  true if it can be read ahead.
+ */
+
+bool chd_file::readahead_possible(UINT32 hunknum)
+{
+	if (!m_cacheable || m_allow_writes || !compressed())
+		return false;
+
+	switch (m_version)
+	{
+		case 3:
+		case 4:
+			return (m_rawmap[16 * hunknum + 15] & V34_MAP_ENTRY_FLAG_TYPE_MASK) == V34_MAP_ENTRY_TYPE_COMPRESSED;
+
+		case 5:
+			return m_rawmap[m_mapentrybytes * hunknum] <= COMPRESSION_TYPE_3;
+	}
+	return false;
+}
+
+/**
+ * @fn  void *chd_file::async_read_hunk_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_read_hunk_static - thunk for reading a hunk ahead on a worker thread
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the cache entry.
+ * @param   threadid        The threadid.
+ *
+ * @return  null.
+ */
+
+void *chd_file::async_read_hunk_static(void *param, int threadid)
+{
+	auto entry = reinterpret_cast<cache_entry *>(param);
+	entry->m_error = entry->m_chd->async_read_hunk(entry->m_hunknum, &entry->m_data[0], threadid);
+	return nullptr;
+}
+
+/**
+ * @fn  chd_error chd_file::async_read_hunk(UINT32 hunknum, UINT8 *dest, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_read_hunk - read and decompress a hunk on a worker thread, using codecs
+ *            private to that thread
+ *          -------------------------------------------------.
+ *
+ * @exception   CHDERR_DECOMPRESSION_ERROR  Thrown when a chderr decompression error error
+ *                                          condition occurs.
+ *
+ * @param   hunknum         The hunknum; readahead_possible() must be true for it.
+ * @param [in,out]  dest    The hunk buffer.
+ * @param   threadid        The threadid.
+ *
+ * @return  A chd_error.
+ */
+
+chd_error chd_file::async_read_hunk(UINT32 hunknum, UINT8 *dest, int threadid)
+{
+	// wrap this for clean reporting
+	try
+	{
+		// decode the map entry
+		UINT64 blockoffs;
+		UINT32 blocklen;
+		UINT32 blockcrc;
+		int codec;
+		bool checkcrc = true;
+		const UINT8 *rawmap;
+		if (m_version < 5)
+		{
+			rawmap = &m_rawmap[16 * hunknum];
+			blockoffs = be_read(&rawmap[0], 8);
+			blockcrc = be_read(&rawmap[8], 4);
+			blocklen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
+			checkcrc = !(rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC);
+			codec = 0;
+		}
+		else
+		{
+			rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+			blocklen = be_read(&rawmap[1], 3);
+			blockoffs = be_read(&rawmap[4], 6);
+			blockcrc = be_read(&rawmap[10], 2);
+			codec = rawmap[0];
+		}
+
+		// codecs are created here so that only the threads which actually run get them
+		chd_decompressor *&decompressor = m_async_decompressor[threadid][codec];
+		if (decompressor == nullptr)
+			decompressor = chd_codec_list::new_decompressor(m_compression[codec], *this);
+		if (decompressor == nullptr)
+			throw CHDERR_UNKNOWN_COMPRESSION;
+
+		// read the compressed data; file_read serializes us against the owning thread
+		dynamic_buffer &buffer = m_async_compressed[threadid];
+		buffer.resize(m_hunkbytes);
+		const UINT8 *compdata = file_read_mapped(blockoffs, blocklen, buffer);
+
+		// decompress and check it the same way read_hunk does
+		decompressor->decompress(compdata, blocklen, dest, m_hunkbytes);
+		if (m_version < 5)
+		{
+			if (checkcrc && crc32_creator::simple(dest, m_hunkbytes) != blockcrc)
+				throw CHDERR_DECOMPRESSION_ERROR;
+		}
+		else if (!decompressor->lossy() && crc16_creator::simple(dest, m_hunkbytes) != blockcrc)
+			throw CHDERR_DECOMPRESSION_ERROR;
+		else if (decompressor->lossy() && crc16_creator::simple(compdata, blocklen) != blockcrc)
+			throw CHDERR_DECOMPRESSION_ERROR;
+		return CHDERR_NONE;
+	}
+
+	// just return errors
+	catch (chd_error &err)
+	{
+		return err;
+	}
+}
+
 /**
  * @fn  bool chd_file::metadata_find(chd_metadata_tag metatag, INT32 metaindex, metadata_entry &metaentry, bool resume)
  *
@@ -17,6 +17,8 @@
 #include "coretmpl.h"
 #include "corestr.h"
 #include <string>
+#include <vector>
+#include <mutex>
 #include "bitmap.h"
 #include "corefile.h"
 #include "hashing.h"
@@ -298,6 +300,13 @@ class chd_file
 	static const UINT32 V5_HEADER_SIZE = 124;
 	static const UINT32 MAX_HEADER_SIZE = V5_HEADER_SIZE;
 
+	// cache defaults: a single hunk, no read ahead
+	static const UINT32 DEFAULT_CACHE_HUNKS = 1;
+	static const UINT32 DEFAULT_READAHEAD_HUNKS = 0;
+
+	// sequential hunk accesses in a row before reading ahead
+	static const UINT32 READAHEAD_TRIGGER = 2;
+
 public:
 	// construction/destruction
 	chd_file();
@@ -341,11 +350,19 @@ public:
 
 	// read/write
 	chd_error read_hunk(UINT32 hunknum, void *buffer);
+	chd_error read_compressed_hunk(UINT32 hunknum, dynamic_buffer &buffer, UINT32 &complen, chd_codec_type &codec);
 	chd_error write_hunk(UINT32 hunknum, const void *buffer);
 	chd_error read_units(UINT64 unitnum, void *buffer, UINT32 count = 1);
 	chd_error write_units(UINT64 unitnum, const void *buffer, UINT32 count = 1);
 	chd_error read_bytes(UINT64 offset, void *buffer, UINT32 bytes);
 	chd_error write_bytes(UINT64 offset, const void *buffer, UINT32 bytes);
+	const UINT8 *mapped_hunk(UINT32 hunknum);
+
+	// hunk cache
+	void set_cache_size(UINT32 hunks, UINT32 readahead);
+	UINT64 cache_hits() const { return m_cache_hits; }
+	UINT64 cache_misses() const { return m_cache_misses; }
+	UINT64 readahead_hits() const { return m_readahead_hits; }
 
 	// metadata management
 	chd_error read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, std::string &output);
@@ -371,12 +388,35 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// a single decompressed hunk in the cache
+	struct cache_entry
+	{
+		cache_entry()
+			: m_chd(nullptr)
+			, m_hunknum(~0)
+			, m_lastuse(0)
+			, m_osd(nullptr)
+			, m_error(CHDERR_NONE)
+			, m_readahead(false)
+		{ }
+
+		chd_file *          m_chd;              // pointer back to the file
+		UINT32              m_hunknum;          // which hunk is in this entry, ~0 if none
+		UINT64              m_lastuse;          // cache clock at the last use
+		osd_work_item *     m_osd;              // read ahead in progress
+		chd_error           m_error;            // result of the read ahead
+		bool                m_readahead;        // read ahead and not used yet?
+		dynamic_buffer      m_data;             // decompressed data
+	};
+
 	// inline helpers
 	UINT64 be_read(const UINT8 *base, int numbytes);
 	void be_write(UINT8 *base, UINT64 value, int numbytes);
 	sha1_t be_read_sha1(const UINT8 *base);
 	void be_write_sha1(UINT8 *base, sha1_t value);
 	void file_read(UINT64 offset, void *dest, UINT32 length);
+	const UINT8 *file_mapped(UINT64 offset, UINT32 length);
+	const UINT8 *file_read_mapped(UINT64 offset, UINT32 length, dynamic_buffer &buffer);
 	void file_write(UINT64 offset, const void *source, UINT32 length);
 	UINT64 file_append(const void *source, UINT32 length, UINT32 alignment = 0);
 	UINT8 bits_for_value(UINT64 value);
@@ -395,6 +435,16 @@ private:
 	void hunk_write_compressed(UINT32 hunknum, INT8 compression, const UINT8 *compressed, UINT32 complength, crc16_t crc16);
 	void hunk_copy_from_self(UINT32 hunknum, UINT32 otherhunk);
 	void hunk_copy_from_parent(UINT32 hunknum, UINT64 parentunit);
+	chd_error read_hunk_uncached(UINT32 hunknum, void *buffer);
+	cache_entry *cache_find(UINT32 hunknum);
+	cache_entry *cache_victim(const cache_entry *keep);
+	UINT8 *cache_hunk(UINT32 hunknum, chd_error &err);
+	void cache_note_access(UINT32 hunknum, const cache_entry *keep);
+	void cache_wait(cache_entry &entry);
+	void cache_reset();
+	bool readahead_possible(UINT32 hunknum);
+	static void *async_read_hunk_static(void *param, int threadid);
+	chd_error async_read_hunk(UINT32 hunknum, UINT8 *dest, int threadid);
 	bool metadata_find(chd_metadata_tag metatag, INT32 metaindex, metadata_entry &metaentry, bool resume = false);
 	void metadata_set_previous_next(UINT64 prevoffset, UINT64 nextoffset);
 	void metadata_update_hash();
@@ -405,6 +455,8 @@ private:
 	bool                    m_owns_file;        // flag indicating if this file should be closed on chd_close()
 	bool                    m_allow_reads;      // permit reads from this CHD?
 	bool                    m_allow_writes;     // permit writes to this CHD?
+	const UINT8 *           m_mapped;           // file data mapped into memory, if possible
+	UINT64                  m_mapped_length;    // length of the mapped data
 
 	// core parameters from the header
 	UINT32                  m_version;          // version of the header
@@ -435,8 +487,22 @@ private:
 	dynamic_buffer          m_compressed;       // temporary buffer for compressed data
 
 	// caching
-	dynamic_buffer          m_cache;            // single-hunk cache for partial reads/writes
-	UINT32                  m_cachehunk;        // which hunk is in the cache?
+	std::vector<cache_entry> m_cache;           // LRU cache for partial reads/writes and read ahead
+	UINT32                  m_cache_hunks;      // number of hunks to cache
+	bool                    m_cacheable;        // false if the codecs need per-read configuration
+	UINT64                  m_cacheclock;       // incremented on every cache access
+	UINT64                  m_cache_hits;       // hunks found in the cache
+	UINT64                  m_cache_misses;     // hunks read synchronously
+	UINT64                  m_readahead_hits;   // hunks found in the cache thanks to read ahead
+
+	// read ahead
+	UINT32                  m_readahead;        // hunks to read ahead on sequential access
+	UINT32                  m_lasthunk;         // last hunk accessed
+	UINT32                  m_sequential;       // sequential accesses in a row
+	osd_work_queue *        m_readahead_queue;  // queue for reading ahead on other threads
+	std::mutex              m_file_lock;        // serializes file access with read ahead
+	chd_decompressor *      m_async_decompressor[WORK_MAX_THREADS + 1][4]; // codecs per worker thread, plus the waiting thread
+	dynamic_buffer          m_async_compressed[WORK_MAX_THREADS + 1]; // compressed data per worker thread
 };
 
 
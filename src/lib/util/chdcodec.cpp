@@ -18,6 +18,9 @@
 #include <zlib.h>
 #include "lzma/C/LzmaEnc.h"
 #include "lzma/C/LzmaDec.h"
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
 #include <new>
 
 
@@ -159,6 +162,48 @@ private:
 };
 
 
+#ifdef USE_ZSTD
+
+// ======================> chd_zstd_compressor
+
+// Zstandard compressor
+class chd_zstd_compressor : public chd_compressor
+{
+public:
+	// construction/destruction
+	chd_zstd_compressor(chd_file &chd, UINT32 hunkbytes, bool lossy);
+	~chd_zstd_compressor();
+
+	// core functionality
+	virtual UINT32 compress(const UINT8 *src, UINT32 srclen, UINT8 *dest) override;
+
+private:
+	// internal state
+	ZSTD_CCtx *             m_context;
+};
+
+
+// ======================> chd_zstd_decompressor
+
+// Zstandard decompressor
+class chd_zstd_decompressor : public chd_decompressor
+{
+public:
+	// construction/destruction
+	chd_zstd_decompressor(chd_file &chd, UINT32 hunkbytes, bool lossy);
+	~chd_zstd_decompressor();
+
+	// core functionality
+	virtual void decompress(const UINT8 *src, UINT32 complen, UINT8 *dest, UINT32 destlen) override;
+
+private:
+	// internal state
+	ZSTD_DCtx *             m_context;
+};
+
+#endif
+
+
 // ======================> chd_huffman_compressor
 
 // Huffman compressor
@@ -468,11 +513,17 @@ const chd_codec_list::codec_entry chd_codec_list::s_codec_list[] =
 	{ CHD_CODEC_LZMA,       false,  "LZMA",                 &chd_codec_list::construct_compressor<chd_lzma_compressor>,     &chd_codec_list::construct_decompressor<chd_lzma_decompressor> },
 	{ CHD_CODEC_HUFFMAN,    false,  "Huffman",              &chd_codec_list::construct_compressor<chd_huffman_compressor>,  &chd_codec_list::construct_decompressor<chd_huffman_decompressor> },
 	{ CHD_CODEC_FLAC,       false,  "FLAC",                 &chd_codec_list::construct_compressor<chd_flac_compressor>,     &chd_codec_list::construct_decompressor<chd_flac_decompressor> },
+#ifdef USE_ZSTD
+	{ CHD_CODEC_ZSTD,       false,  "Zstandard",            &chd_codec_list::construct_compressor<chd_zstd_compressor>,     &chd_codec_list::construct_decompressor<chd_zstd_decompressor> },
+#endif
 
 	// general codecs with CD frontend
 	{ CHD_CODEC_CD_ZLIB,    false,  "CD Deflate",           &chd_codec_list::construct_compressor<chd_cd_compressor<chd_zlib_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_zlib_decompressor, chd_zlib_decompressor> > },
 	{ CHD_CODEC_CD_LZMA,    false,  "CD LZMA",              &chd_codec_list::construct_compressor<chd_cd_compressor<chd_lzma_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_lzma_decompressor, chd_zlib_decompressor> > },
 	{ CHD_CODEC_CD_FLAC,    false,  "CD FLAC",              &chd_codec_list::construct_compressor<chd_cd_flac_compressor>,  &chd_codec_list::construct_decompressor<chd_cd_flac_decompressor> },
+#ifdef USE_ZSTD
+	{ CHD_CODEC_CD_ZSTD,    false,  "CD Zstandard",         &chd_codec_list::construct_compressor<chd_cd_compressor<chd_zstd_compressor, chd_zstd_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_zstd_decompressor, chd_zstd_decompressor> > },
+#endif
 
 	// A/V codecs
 	{ CHD_CODEC_AVHUFF,     false,  "A/V Huffman",          &chd_codec_list::construct_compressor<chd_avhuff_compressor>,   &chd_codec_list::construct_decompressor<chd_avhuff_decompressor> },
@@ -1178,6 +1229,96 @@ void chd_lzma_decompressor::decompress(const UINT8 *src, UINT32 complen, UINT8 *
 
 
 
+#ifdef USE_ZSTD
+
+//**************************************************************************
+//  ZSTANDARD COMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_compressor - constructor
+//-------------------------------------------------
+
+chd_zstd_compressor::chd_zstd_compressor(chd_file &chd, UINT32 hunkbytes, bool lossy)
+	: chd_compressor(chd, hunkbytes, lossy),
+		m_context(ZSTD_createCCtx())
+{
+	if (m_context == nullptr)
+		throw std::bad_alloc();
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_compressor - destructor
+//-------------------------------------------------
+
+chd_zstd_compressor::~chd_zstd_compressor()
+{
+	ZSTD_freeCCtx(m_context);
+}
+
+
+//-------------------------------------------------
+//  compress - compress data using the Zstandard
+//  codec; compression time doesn't matter, so go
+//  for the best ratio
+//-------------------------------------------------
+
+UINT32 chd_zstd_compressor::compress(const UINT8 *src, UINT32 srclen, UINT8 *dest)
+{
+	size_t complen = ZSTD_compressCCtx(m_context, dest, srclen, src, srclen, ZSTD_maxCLevel());
+
+	// if we ended up with more data than we started with, return an error
+	if (ZSTD_isError(complen) || complen >= srclen)
+		throw CHDERR_COMPRESSION_ERROR;
+	return complen;
+}
+
+
+
+//**************************************************************************
+//  ZSTANDARD DECOMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_decompressor - constructor
+//-------------------------------------------------
+
+chd_zstd_decompressor::chd_zstd_decompressor(chd_file &chd, UINT32 hunkbytes, bool lossy)
+	: chd_decompressor(chd, hunkbytes, lossy),
+		m_context(ZSTD_createDCtx())
+{
+	if (m_context == nullptr)
+		throw std::bad_alloc();
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_decompressor - destructor
+//-------------------------------------------------
+
+chd_zstd_decompressor::~chd_zstd_decompressor()
+{
+	ZSTD_freeDCtx(m_context);
+}
+
+
+//-------------------------------------------------
+//  decompress - decompress data using the
+//  Zstandard codec
+//-------------------------------------------------
+
+void chd_zstd_decompressor::decompress(const UINT8 *src, UINT32 complen, UINT8 *dest, UINT32 destlen)
+{
+	size_t result = ZSTD_decompressDCtx(m_context, dest, destlen, src, complen);
+	if (ZSTD_isError(result) || result != destlen)
+		throw CHDERR_DECOMPRESSION_ERROR;
+}
+
+#endif
+
+
+
 //**************************************************************************
 //  HUFFMAN COMPRESSOR
 //**************************************************************************
@@ -70,6 +70,8 @@ struct core_file
 	UINT32          openflags;                  /* flags we were opened with */
 	UINT8           data_allocated;             /* was the data allocated by us? */
 	UINT8 *         data;                       /* file data, if RAM-based */
+	const void *    mapped;                     /* file data, if mapped by core_fmap */
+	UINT64          maplength;                  /* length of the mapping */
 	UINT64          offset;                     /* current file offset */
 	UINT64          length;                     /* total file length */
 	text_file_type  text_type;                  /* text output format */
@@ -216,6 +218,8 @@ void core_fclose(core_file *file)
 		osd_close(file->file);
 	if (file->data != nullptr && file->data_allocated)
 		free(file->data);
+	if (file->mapped != nullptr)
+		osd_unmap(file->mapped, file->maplength);
 	free(file);
 }
 
@@ -684,6 +688,36 @@ const void *core_fbuffer(core_file *file)
 }
 
 
+/*-------------------------------------------------
+    core_fmap - return a pointer to the file
+    data mapped into memory; RAM-based files
+    return their buffer, and compressed files
+    or OSD files that can't be mapped return
+    nullptr
+-------------------------------------------------*/
+
+const void *core_fmap(core_file *file)
+{
+	/* RAM-based or already mapped files need no work */
+	if (file->data != nullptr)
+		return file->data;
+	if (file->mapped != nullptr)
+		return file->mapped;
+
+	/* the mapping holds the raw file data, so it's useless when compressed */
+	if (file->file == nullptr || file->zdata != nullptr || file->length == 0)
+		return nullptr;
+
+	/* ask the OSD to map it */
+	const void *base;
+	if (osd_map(file->file, file->length, &base) != FILERR_NONE)
+		return nullptr;
+	file->mapped = base;
+	file->maplength = file->length;
+	return file->mapped;
+}
+
+
 /*-------------------------------------------------
     core_fload - open a file with the specified
     filename, read it into memory, and return a
@@ -99,6 +99,11 @@ char *core_fgets(char *s, int n, core_file *file);
 /* this function may cause the full file data to be read */
 const void *core_fbuffer(core_file *file);
 
+/* get a pointer to the file data mapped read-only into memory, or nullptr if */
+/* the file can't be mapped; this never reads the file, and the pointer stays */
+/* valid until the file is closed */
+const void *core_fmap(core_file *file);
+
 /* open a file with the specified filename, read it into memory, and return a pointer */
 file_error core_fload(const char *filename, void **data, UINT32 *length);
 file_error core_fload(const char *filename, dynamic_buffer &data);
@@ -121,12 +121,14 @@
 //  decoding context
 //-------------------------------------------------
 
-huffman_context_base::huffman_context_base(int numcodes, int maxbits, lookup_value *lookup, UINT32 *histo, node_t *nodes)
+huffman_context_base::huffman_context_base(int numcodes, int maxbits, lookup_value *lookup, UINT16 *sorted, UINT32 *histo, node_t *nodes)
 	: m_numcodes(numcodes),
 		m_maxbits(maxbits),
+		m_fastbits((maxbits < FAST_BITS) ? maxbits : int(FAST_BITS)),
 		m_prevdata(0),
 		m_rleremaining(0),
 		m_lookup(lookup),
+		m_sorted(sorted),
 		m_datahisto(histo),
 		m_huffnode(nodes)
 {
@@ -652,24 +654,88 @@ huffman_error huffman_context_base::assign_canonical_codes()
 
 void huffman_context_base::build_lookup_table()
 {
+	// codes longer than the table are flagged with a zero length
+	UINT32 tablesize = 1 << m_fastbits;
+	memset(m_lookup, 0, tablesize * sizeof(m_lookup[0]));
+
 	// iterate over all codes
+	UINT32 slowcount[25] = { 0 };
 	for (int curcode = 0; curcode < m_numcodes; curcode++)
 	{
 		// process all nodes which have non-zero bits
 		node_t &node = m_huffnode[curcode];
-		if (node.m_numbits > 0)
+		if (node.m_numbits > m_fastbits)
+		{
+			// remember where the longer codes start, then count them
+			if (slowcount[node.m_numbits]++ == 0)
+				m_slowstart[node.m_numbits] = node.m_bits << (m_maxbits - node.m_numbits);
+		}
+		else if (node.m_numbits > 0)
 		{
 			// set up the entry
 			lookup_value value = MAKE_LOOKUP(curcode, node.m_numbits);
 
 			// fill all matching entries
-			int shift = m_maxbits - node.m_numbits;
-			lookup_value *dest = &m_lookup[node.m_bits << shift];
-			lookup_value *destend = &m_lookup[((node.m_bits + 1) << shift) - 1];
-			while (dest <= destend)
-				*dest++ = value;
+			int shift = m_fastbits - node.m_numbits;
+			UINT32 start = node.m_bits << shift;
+			UINT32 end = (node.m_bits + 1) << shift;
+			if (end <= tablesize)
+				for (UINT32 index = start; index < end; index++)
+					m_lookup[index] = value;
 		}
 	}
+
+	// pair each code with the next one when both fit in the looked up bits
+	for (UINT32 index = 0; index < tablesize; index++)
+	{
+		lookup_value first = m_lookup[index];
+		int firstbits = first & 0x1f;
+		if (firstbits == 0 || firstbits == m_fastbits)
+			continue;
+		lookup_value second = m_lookup[(index << firstbits) & (tablesize - 1)];
+		int secondbits = second & 0x1f;
+		if (secondbits != 0 && secondbits <= m_fastbits - firstbits)
+			m_lookup[index] = first | ((firstbits + secondbits) << 15) | (((second >> 5) & 0x3ff) << 20);
+	}
+
+	// index the longer codes by length, in code order within each length
+	UINT32 index = 0;
+	for (int numbits = m_fastbits + 1; numbits <= m_maxbits; numbits++)
+	{
+		if (slowcount[numbits] == 0)
+			m_slowstart[numbits] = ~0;
+		m_slowindex[numbits] = m_slowend[numbits] = index;
+		index += slowcount[numbits];
+	}
+	for (int curcode = 0; curcode < m_numcodes; curcode++)
+	{
+		node_t &node = m_huffnode[curcode];
+		if (node.m_numbits > m_fastbits)
+			m_sorted[m_slowend[node.m_numbits]++] = curcode;
+	}
+}
+
+
+//-------------------------------------------------
+//  decode_slow - decode a code that is longer
+//  than the lookup table from the given maxbits
+//  worth of peeked data
+//-------------------------------------------------
+
+UINT32 huffman_context_base::decode_slow(bitstream_in &bitbuf, UINT32 bits)
+{
+	// canonical codes of each length sit above all the longer ones
+	for (int numbits = m_fastbits + 1; numbits <= m_maxbits; numbits++)
+		if (bits >= m_slowstart[numbits])
+		{
+			bitbuf.remove(numbits);
+			UINT32 index = m_slowindex[numbits] + ((bits - m_slowstart[numbits]) >> (m_maxbits - numbits));
+			return (index < m_slowend[numbits]) ? m_sorted[index] : 0;
+		}
+
+	// not a valid code
+	bitbuf.remove(m_maxbits);
+	return 0;
 }
 
 
@@ -754,8 +820,7 @@ huffman_error huffman_8bit_decoder::decode(const UINT8 *source, UINT32 slength,
 		return err;
 
 	// then decode the data
-	for (UINT32 cur = 0; cur < dlength; cur++)
-		dest[cur] = decode_one(bitbuf);
+	decode_multiple(bitbuf, dest, dlength);
 	bitbuf.flush();
 	return bitbuf.overflow() ? HUFFERR_INPUT_BUFFER_TOO_SMALL : HUFFERR_NONE;
 }
@@ -44,7 +44,16 @@ enum huffman_error
 class huffman_context_base
 {
 protected:
-	typedef UINT16 lookup_value;
+	// codes up to this many bits are decoded with a single table lookup
+	static const int FAST_BITS = 11;
+
+	// lookup table entries hold the first code in the looked up bits and,
+	// if it fits as well, the one after it:
+	//   bits  0- 4: length of the first code (0 if it is longer than the table)
+	//   bits  5-14: first code
+	//   bits 15-19: combined length of both codes (0 if only one fits)
+	//   bits 20-29: second code
+	typedef UINT32 lookup_value;
 
 	// a node in the huffman tree
 	struct node_t
@@ -57,7 +66,7 @@ protected:
 	};
 
 	// construction/destruction
-	huffman_context_base(int numcodes, int maxbits, lookup_value *lookup, UINT32 *histo, node_t *nodes);
+	huffman_context_base(int numcodes, int maxbits, lookup_value *lookup, UINT16 *sorted, UINT32 *histo, node_t *nodes);
 
 	// tree creation
 	huffman_error compute_tree_from_histo();
@@ -76,14 +85,20 @@ protected:
 	int build_tree(UINT32 totaldata, UINT32 totalweight);
 	huffman_error assign_canonical_codes();
 	void build_lookup_table();
+	UINT32 decode_slow(bitstream_in &bitbuf, UINT32 bits);
 
 protected:
 	// internal state
 	UINT32                  m_numcodes;             // number of total codes being processed
 	UINT8                   m_maxbits;              // maximum bits per code
+	UINT8                   m_fastbits;             // bits looked up in the lookup table
 	UINT8                   m_prevdata;             // value of the previous data (for delta-RLE encoding)
 	int                     m_rleremaining;         // number of RLE bytes remaining (for delta-RLE encoding)
 	lookup_value *          m_lookup;               // pointer to the lookup table
+	UINT16 *                m_sorted;               // codes longer than the lookup table, by length
+	UINT32                  m_slowstart[25];        // first maxbits-wide value of each code length
+	UINT32                  m_slowindex[25];        // index in m_sorted of the first code of each length
+	UINT32                  m_slowend[25];          // index in m_sorted past the last code of each length
 	UINT32 *                m_datahisto;            // histogram of data values
 	node_t *                m_huffnode;             // array of nodes
 };
@@ -98,7 +113,7 @@ class huffman_encoder : public huffman_context_base
 public:
 	// pass through to the underlying constructor
 	huffman_encoder()
-		: huffman_context_base(_NumCodes, _MaxBits, nullptr, m_datahisto_array, m_huffnode_array) { histo_reset(); }
+		: huffman_context_base(_NumCodes, _MaxBits, nullptr, nullptr, m_datahisto_array, m_huffnode_array) { histo_reset(); }
 
 	// single item operations
 	void histo_reset() { memset(m_datahisto_array, 0, sizeof(m_datahisto_array)); }
@@ -126,19 +141,28 @@ class huffman_decoder : public huffman_context_base
 public:
 	// pass through to the underlying constructor
 	huffman_decoder()
-		: huffman_context_base(_NumCodes, _MaxBits, m_lookup_array, nullptr, m_huffnode_array) { }
+		: huffman_context_base(_NumCodes, _MaxBits, m_lookup_array, m_sorted_array, nullptr, m_huffnode_array) { }
 
 	// single item operations
 	UINT32 decode_one(bitstream_in &bitbuf);
 
+	// bulk operations, taking two codes per lookup where they fit
+	void decode_multiple(bitstream_in &bitbuf, UINT8 *dest, UINT32 count);
+
+	// interleaved operations, alternating codes with a second tree
+	void decode_pairs(bitstream_in &bitbuf, huffman_decoder &second, UINT16 *dest, UINT32 count);
+
 	// expose tree import
 	using huffman_context_base::import_tree_rle;
 	using huffman_context_base::import_tree_huffman;
 
 private:
+	static_assert(_NumCodes <= 1024, "huffman_decoder lookup entries hold 10-bit codes");
+
 	// array versions of the info we need
 	node_t                  m_huffnode_array[_NumCodes];
-	lookup_value            m_lookup_array[1 << _MaxBits];
+	lookup_value            m_lookup_array[1 << ((_MaxBits < FAST_BITS) ? _MaxBits : FAST_BITS)];
+	UINT16                  m_sorted_array[_NumCodes];
 };
 
 
@@ -212,12 +236,89 @@ inline UINT32 huffman_decoder<_NumCodes, _MaxBits>::decode_one(bitstream_in &bit
 	UINT32 bits = bitbuf.peek(m_maxbits);
 
 	// look it up, then remove the actual number of bits for this code
-	lookup_value lookup = m_lookup[bits];
+	lookup_value lookup = m_lookup[bits >> (m_maxbits - m_fastbits)];
+	if ((lookup & 0x1f) == 0)
+		return decode_slow(bitbuf, bits);
 	bitbuf.remove(lookup & 0x1f);
 
 	// return the value
-	return lookup >> 5;
+	return (lookup >> 5) & 0x3ff;
+}
+
+
+//-------------------------------------------------
+//  decode_multiple - decode a run of codes from
+//  the huffman stream
+//-------------------------------------------------
+
+template<int _NumCodes, int _MaxBits>
+inline void huffman_decoder<_NumCodes, _MaxBits>::decode_multiple(bitstream_in &bitbuf, UINT8 *dest, UINT32 count)
+{
+	UINT8 *destend = dest + count;
+	while (destend - dest >= 2)
+	{
+		UINT32 bits = bitbuf.peek(m_maxbits);
+		lookup_value lookup = m_lookup[bits >> (m_maxbits - m_fastbits)];
+
+		// two codes in one go
+		if ((lookup >> 15) & 0x1f)
+		{
+			dest[0] = lookup >> 5;
+			dest[1] = lookup >> 20;
+			bitbuf.remove((lookup >> 15) & 0x1f);
+			dest += 2;
+		}
+
+		// one code, or a long one
+		else if (lookup & 0x1f)
+		{
+			*dest++ = lookup >> 5;
+			bitbuf.remove(lookup & 0x1f);
+		}
+		else
+			*dest++ = decode_slow(bitbuf, bits);
+	}
+	if (dest < destend)
+		*dest = decode_one(bitbuf);
 }
 
 
+//-------------------------------------------------
+//  decode_pairs - decode a run of codes that
+//  alternate between this tree and a second one,
+//  returning each pair as (first << 8) | second
+//-------------------------------------------------
+
+template<int _NumCodes, int _MaxBits>
+inline void huffman_decoder<_NumCodes, _MaxBits>::decode_pairs(bitstream_in &bitbuf, huffman_decoder &second, UINT16 *dest, UINT32 count)
+{
+	static_assert(_NumCodes <= 256 && _MaxBits <= 16, "decode_pairs packs two 8-bit codes of up to 16 bits each");
+
+	const int shift = 32 - m_fastbits;
+	for (UINT32 index = 0; index < count; index++)
+	{
+		// one peek covers both codes, so look up the second straight after the first
+		UINT32 bits = bitbuf.peek(32);
+		lookup_value first = m_lookup[bits >> shift];
+		int firstbits = first & 0x1f;
+		if (firstbits == 0)
+		{
+			dest[index] = (decode_one(bitbuf) << 8) | second.decode_one(bitbuf);
+			continue;
+		}
+		lookup_value next = second.m_lookup[(bits << firstbits) >> shift];
+		int nextbits = next & 0x1f;
+		if (nextbits != 0)
+		{
+			dest[index] = (((first >> 5) & 0xff) << 8) | ((next >> 5) & 0xff);
+			bitbuf.remove(firstbits + nextbits);
+		}
+		else
+		{
+			bitbuf.remove(firstbits);
+			dest[index] = (((first >> 5) & 0xff) << 8) | second.decode_one(bitbuf);
+		}
+	}
+}
+
 #endif
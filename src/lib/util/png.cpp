@@ -17,6 +17,14 @@
 
 #include <new>
 
+/* the 3 and 4 byte per pixel unfilters are vectorized where SSE2 is always present */
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define PNG_USE_SSE2    1
+#include <emmintrin.h>
+#else
+#define PNG_USE_SSE2    0
+#endif
+
 
 /***************************************************************************
     TYPE DEFINITIONS
@@ -333,74 +341,203 @@ static png_error process_chunk(png_private *png, UINT8 *data, UINT32 type, UINT3
 
 
 /*-------------------------------------------------
-    unfilter_row - unfilter a single row of pixels
+    paeth_predictor - the Paeth predictor for a
+    byte given its left, above and upper left
+    neighbours
+-------------------------------------------------*/
+
+static inline UINT8 paeth_predictor(INT32 a, INT32 b, INT32 c)
+{
+	INT32 prediction = a + b - c;
+	INT32 da = abs(prediction - a);
+	INT32 db = abs(prediction - b);
+	INT32 dc = abs(prediction - c);
+	if (da <= db && da <= dc)
+		return a;
+	else if (db <= dc)
+		return b;
+	else
+		return c;
+}
+
+
+#if PNG_USE_SSE2
+
+/*-------------------------------------------------
+    load_pixel/store_pixel - move a single 3 or
+    4 byte pixel in and out of a vector register;
+    the bytes are assembled in a general register
+    since going through memory a byte at a time
+    stalls store forwarding
+-------------------------------------------------*/
+
+template<int _Bpp>
+static inline __m128i load_pixel(const UINT8 *src)
+{
+	UINT32 raw = src[0] | (src[1] << 8) | (src[2] << 16);
+	if (_Bpp == 4)
+		raw |= src[3] << 24;
+	return _mm_cvtsi32_si128(raw);
+}
+
+template<int _Bpp>
+static inline void store_pixel(UINT8 *dst, __m128i pixel)
+{
+	UINT32 raw = _mm_cvtsi128_si32(pixel);
+	dst[0] = raw;
+	dst[1] = raw >> 8;
+	dst[2] = raw >> 16;
+	if (_Bpp == 4)
+		dst[3] = raw >> 24;
+}
+
+
+/*-------------------------------------------------
+    unfilter_row_sse2 - unfilter a row of 3 or 4
+    byte pixels a whole pixel at a time; returns
+    false for filters handled by unfilter_row
 -------------------------------------------------*/
 
-static png_error unfilter_row(int type, UINT8 *src, UINT8 *dst, UINT8 *dstprev, int bpp, int rowbytes)
+template<int _Bpp>
+static bool unfilter_row_sse2(int type, const UINT8 *src, UINT8 *dst, const UINT8 *dstprev, int rowbytes)
 {
+	const __m128i zero = _mm_setzero_si128();
 	int x;
 
+	switch (type)
+	{
+		/* SUB = previous pixel */
+		case PNG_PF_Sub:
+		{
+			__m128i a = zero;
+			for (x = 0; x < rowbytes; x += _Bpp)
+			{
+				a = _mm_add_epi8(a, load_pixel<_Bpp>(src + x));
+				store_pixel<_Bpp>(dst + x, a);
+			}
+			return true;
+		}
+
+		/* AVERAGE = average of pixel above and previous pixel */
+		case PNG_PF_Average:
+		{
+			const __m128i ones = _mm_set1_epi8(1);
+			__m128i a = zero;
+			for (x = 0; x < rowbytes; x += _Bpp)
+			{
+				/* pavgb rounds up, so take off the carry from odd sums */
+				__m128i b = load_pixel<_Bpp>(dstprev + x);
+				__m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), ones));
+				a = _mm_add_epi8(average, load_pixel<_Bpp>(src + x));
+				store_pixel<_Bpp>(dst + x, a);
+			}
+			return true;
+		}
+
+		/* PAETH = special filter, done in 16 bits per channel */
+		case PNG_PF_Paeth:
+		{
+			__m128i a = zero, c = zero;
+			for (x = 0; x < rowbytes; x += _Bpp)
+			{
+				__m128i b = _mm_unpacklo_epi8(load_pixel<_Bpp>(dstprev + x), zero);
+
+				/* distances from the prediction a + b - c to a, b and c */
+				__m128i pa = _mm_sub_epi16(b, c);
+				__m128i pb = _mm_sub_epi16(a, c);
+				__m128i pc = _mm_add_epi16(pa, pb);
+				pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+				pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+				pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+
+				/* pick a, then b, then c on ties */
+				__m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+				__m128i usea = _mm_cmpeq_epi16(smallest, pa);
+				__m128i useb = _mm_andnot_si128(usea, _mm_cmpeq_epi16(smallest, pb));
+				__m128i usec = _mm_andnot_si128(_mm_or_si128(usea, useb), _mm_set1_epi16(-1));
+				__m128i nearest = _mm_or_si128(_mm_or_si128(_mm_and_si128(usea, a), _mm_and_si128(useb, b)), _mm_and_si128(usec, c));
+
+				a = _mm_and_si128(_mm_add_epi16(nearest, _mm_unpacklo_epi8(load_pixel<_Bpp>(src + x), zero)), _mm_set1_epi16(0xff));
+				store_pixel<_Bpp>(dst + x, _mm_packus_epi16(a, a));
+				c = b;
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif
+
+
+/*-------------------------------------------------
+    unfilter_row - unfilter a single row of pixels;
+    dstprev is the previous unfiltered row, or a
+    row of zeroes for the first row, and dst may
+    trail src within the same buffer
+-------------------------------------------------*/
+
+static png_error unfilter_row(int type, const UINT8 *src, UINT8 *dst, const UINT8 *dstprev, int bpp, int rowbytes)
+{
+	int x;
+
+#if PNG_USE_SSE2
+	/* RGB and RGBA rows carry a dependency from pixel to pixel, so do a pixel per step */
+	if (bpp == 3 && unfilter_row_sse2<3>(type, src, dst, dstprev, rowbytes))
+		return PNGERR_NONE;
+	if (bpp == 4 && unfilter_row_sse2<4>(type, src, dst, dstprev, rowbytes))
+		return PNGERR_NONE;
+#endif
+
+	/* filters work on whole bytes even below 8 bits per pixel */
+	if (bpp < 1)
+		bpp = 1;
+
 	/* switch off of it */
 	switch (type)
 	{
 		/* no filter, just copy */
 		case PNG_PF_None:
-			for (x = 0; x < rowbytes; x++)
-				*dst++ = *src++;
+			memmove(dst, src, rowbytes);
 			break;
 
 		/* SUB = previous pixel */
 		case PNG_PF_Sub:
 			for (x = 0; x < bpp; x++)
-				*dst++ = *src++;
-			for (x = bpp; x < rowbytes; x++, dst++)
-				*dst = *src++ + dst[-bpp];
+				dst[x] = src[x];
+			for (x = bpp; x < rowbytes; x++)
+				dst[x] = src[x] + dst[x - bpp];
 			break;
 
 		/* UP = pixel above */
 		case PNG_PF_Up:
-			if (dstprev == nullptr)
-				return unfilter_row(PNG_PF_None, src, dst, dstprev, bpp, rowbytes);
-			for (x = 0; x < rowbytes; x++, dst++)
-				*dst = *src++ + *dstprev++;
+			x = 0;
+#if PNG_USE_SSE2
+			/* no dependency along the row; loading each block before storing keeps this safe in place */
+			for ( ; x + 16 <= rowbytes; x += 16)
+			{
+				__m128i sum = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(dstprev + x)));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), sum);
+			}
+#endif
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] + dstprev[x];
 			break;
 
 		/* AVERAGE = average of pixel above and previous pixel */
 		case PNG_PF_Average:
-			if (dstprev == nullptr)
-			{
-				for (x = 0; x < bpp; x++)
-					*dst++ = *src++;
-				for (x = bpp; x < rowbytes; x++, dst++)
-					*dst = *src++ + dst[-bpp] / 2;
-			}
-			else
-			{
-				for (x = 0; x < bpp; x++, dst++)
-					*dst = *src++ + *dstprev++ / 2;
-				for (x = bpp; x < rowbytes; x++, dst++)
-					*dst = *src++ + (*dstprev++ + dst[-bpp]) / 2;
-			}
+			for (x = 0; x < bpp; x++)
+				dst[x] = src[x] + dstprev[x] / 2;
+			for (x = bpp; x < rowbytes; x++)
+				dst[x] = src[x] + (dstprev[x] + dst[x - bpp]) / 2;
 			break;
 
 		/* PAETH = special filter */
 		case PNG_PF_Paeth:
-			for (x = 0; x < rowbytes; x++)
-			{
-				INT32 pa = (x < bpp) ? 0 : dst[-bpp];
-				INT32 pc = (x < bpp || dstprev == nullptr) ? 0 : dstprev[-bpp];
-				INT32 pb = (dstprev == nullptr) ? 0 : *dstprev++;
-				INT32 prediction = pa + pb - pc;
-				INT32 da = abs(prediction - pa);
-				INT32 db = abs(prediction - pb);
-				INT32 dc = abs(prediction - pc);
-				if (da <= db && da <= dc)
-					*dst++ = *src++ + pa;
-				else if (db <= dc)
-					*dst++ = *src++ + pb;
-				else
-					*dst++ = *src++ + pc;
-			}
+			for (x = 0; x < bpp; x++)
+				dst[x] = src[x] + dstprev[x];
+			for (x = bpp; x < rowbytes; x++)
+				dst[x] = src[x] + paeth_predictor(dst[x - bpp], dstprev[x], dstprev[x - bpp]);
 			break;
 
 		/* unknown filter type */
@@ -421,7 +558,7 @@ static png_error process_image(png_private *png)
 	int rowbytes, bpp, imagesize;
 	png_error error = PNGERR_NONE;
 	image_data_chunk *idat;
-	UINT8 *src, *dst;
+	UINT8 *src, *dst, *zeroes = nullptr;
 	z_stream stream;
 	int zerr, y;
 
@@ -474,6 +611,14 @@ static png_error process_image(png_private *png)
 		goto handle_error;
 	}
 
+	/* the first row is unfiltered against a row of zeroes */
+	zeroes = (UINT8 *)calloc(rowbytes, 1);
+	if (zeroes == nullptr)
+	{
+		error = PNGERR_OUT_OF_MEMORY;
+		goto handle_error;
+	}
+
 	/* we de-filter in place */
 	src = dst = png->pnginfo->image;
 
@@ -482,12 +627,14 @@ static png_error process_image(png_private *png)
 	{
 		/* first byte of each row is the filter type */
 		int filter = *src++;
-		error = unfilter_row(filter, src, dst, (y == 0) ? nullptr : &dst[-rowbytes], bpp, rowbytes);
+		error = unfilter_row(filter, src, dst, (y == 0) ? zeroes : &dst[-rowbytes], bpp, rowbytes);
 		src += rowbytes;
 		dst += rowbytes;
 	}
 
 handle_error:
+	free(zeroes);
+
 	/* if we errored, free the image data */
 	if (error != PNGERR_NONE)
 	{
@@ -780,10 +927,11 @@ static png_error write_chunk(core_file *fp, const UINT8 *data, UINT32 type, UINT
 
 /*-------------------------------------------------
     write_deflated_chunk - write an in-memory
-    chunk to the given file by deflating it
+    chunk to the given file by deflating it at
+    the given zlib level
 -------------------------------------------------*/
 
-static png_error write_deflated_chunk(core_file *fp, UINT8 *data, UINT32 type, UINT32 length)
+static png_error write_deflated_chunk(core_file *fp, UINT8 *data, UINT32 type, UINT32 length, int level)
 {
 	UINT64 lengthpos = core_ftell(fp);
 	UINT8 tempbuff[8192];
@@ -805,7 +953,7 @@ static png_error write_deflated_chunk(core_file *fp, UINT8 *data, UINT32 type, U
 	memset(&stream, 0, sizeof(stream));
 	stream.next_in = data;
 	stream.avail_in = length;
-	zerr = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
+	zerr = deflateInit(&stream, level);
 	if (zerr != Z_OK)
 		return PNGERR_COMPRESS_ERROR;
 
@@ -1001,12 +1149,169 @@ static png_error convert_bitmap_to_image_rgb(png_info *pnginfo, const bitmap_t &
 }
 
 
+#if PNG_USE_SSE2
+
+/*-------------------------------------------------
+    filter_row_sse2 - compute the Sub, Up, Average
+    and Paeth candidates and their sums for as
+    much of a row as fits in 16 byte blocks,
+    starting at the second pixel; returns where
+    it stopped
+-------------------------------------------------*/
+
+static int filter_row_sse2(const UINT8 *raw, const UINT8 *prev, int bpp, int rowbytes, UINT8 *candidates, UINT32 *sums)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ones = _mm_set1_epi8(1);
+	__m128i sum[5] = { zero, zero, zero, zero, zero };
+	int x;
+
+	for (x = bpp; x + 16 <= rowbytes; x += 16)
+	{
+		const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(raw + x));
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(raw + x - bpp));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + x));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + x - bpp));
+		__m128i filtered[5];
+
+		/* the simple predictors; pavgb rounds up, so take off the carry from odd sums */
+		filtered[PNG_PF_None] = r;
+		filtered[PNG_PF_Sub] = _mm_sub_epi8(r, a);
+		filtered[PNG_PF_Up] = _mm_sub_epi8(r, b);
+		filtered[PNG_PF_Average] = _mm_sub_epi8(r, _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), ones)));
+
+		/* Paeth in 16 bits per byte, half a block at a time */
+		__m128i nearest[2];
+		for (int half = 0; half < 2; half++)
+		{
+			const __m128i a16 = half ? _mm_unpackhi_epi8(a, zero) : _mm_unpacklo_epi8(a, zero);
+			const __m128i b16 = half ? _mm_unpackhi_epi8(b, zero) : _mm_unpacklo_epi8(b, zero);
+			const __m128i c16 = half ? _mm_unpackhi_epi8(c, zero) : _mm_unpacklo_epi8(c, zero);
+			__m128i pa = _mm_sub_epi16(b16, c16);
+			__m128i pb = _mm_sub_epi16(a16, c16);
+			__m128i pc = _mm_add_epi16(pa, pb);
+			pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+			pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+			pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+			const __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+			const __m128i usea = _mm_cmpeq_epi16(smallest, pa);
+			const __m128i useb = _mm_andnot_si128(usea, _mm_cmpeq_epi16(smallest, pb));
+			const __m128i usec = _mm_andnot_si128(_mm_or_si128(usea, useb), _mm_set1_epi16(-1));
+			nearest[half] = _mm_or_si128(_mm_or_si128(_mm_and_si128(usea, a16), _mm_and_si128(useb, b16)), _mm_and_si128(usec, c16));
+		}
+		filtered[PNG_PF_Paeth] = _mm_sub_epi8(r, _mm_packus_epi16(nearest[0], nearest[1]));
+
+		/* store the candidates and add up the magnitudes of the bytes as signed values */
+		for (int type = PNG_PF_None; type <= PNG_PF_Paeth; type++)
+		{
+			if (type != PNG_PF_None)
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(candidates + type * rowbytes + x), filtered[type]);
+			const __m128i magnitude = _mm_min_epu8(filtered[type], _mm_sub_epi8(zero, filtered[type]));
+			sum[type] = _mm_add_epi64(sum[type], _mm_sad_epu8(magnitude, zero));
+		}
+	}
+
+	for (int type = PNG_PF_None; type <= PNG_PF_Paeth; type++)
+		sums[type] += _mm_cvtsi128_si32(sum[type]) + _mm_cvtsi128_si32(_mm_srli_si128(sum[type], 8));
+	return x;
+}
+
+#endif
+
+
+/*-------------------------------------------------
+    filter_image - filter each row of an 8-bit RGB
+    or RGBA image with whichever filter gives the
+    smallest sum of absolute differences, the
+    usual heuristic for helping deflate
+-------------------------------------------------*/
+
+static png_error filter_image(png_info *pnginfo)
+{
+	const int bpp = compute_bpp(pnginfo);
+	const int rowbytes = compute_rowbytes(pnginfo);
+	UINT8 *filtered, *candidates, *zeroes;
+	int x, y;
+
+	/* allocate the filtered image, one row per filter type and a row of zeroes above the first */
+	filtered = (UINT8 *)malloc(pnginfo->height * (rowbytes + 1));
+	candidates = (UINT8 *)malloc(5 * rowbytes);
+	zeroes = (UINT8 *)calloc(rowbytes, 1);
+	if (filtered == nullptr || candidates == nullptr || zeroes == nullptr)
+	{
+		free(filtered);
+		free(candidates);
+		free(zeroes);
+		return PNGERR_OUT_OF_MEMORY;
+	}
+
+	for (y = 0; y < pnginfo->height; y++)
+	{
+		const UINT8 *raw = pnginfo->image + y * (rowbytes + 1) + 1;
+		const UINT8 *prev = (y == 0) ? zeroes : raw - (rowbytes + 1);
+		UINT8 *sub = candidates + PNG_PF_Sub * rowbytes;
+		UINT8 *up = candidates + PNG_PF_Up * rowbytes;
+		UINT8 *average = candidates + PNG_PF_Average * rowbytes;
+		UINT8 *paeth = candidates + PNG_PF_Paeth * rowbytes;
+		UINT32 sums[5] = { 0 };
+
+		/* every filter reads only unfiltered data, so all of them are computed in one pass */
+		x = 0;
+#if PNG_USE_SSE2
+		for ( ; x < bpp; x++)
+		{
+			sub[x] = raw[x];
+			up[x] = raw[x] - prev[x];
+			average[x] = raw[x] - prev[x] / 2;
+			paeth[x] = raw[x] - prev[x];
+			sums[PNG_PF_None] += abs(INT8(raw[x]));
+			sums[PNG_PF_Sub] += abs(INT8(sub[x]));
+			sums[PNG_PF_Up] += abs(INT8(up[x]));
+			sums[PNG_PF_Average] += abs(INT8(average[x]));
+			sums[PNG_PF_Paeth] += abs(INT8(paeth[x]));
+		}
+		x = filter_row_sse2(raw, prev, bpp, rowbytes, candidates, sums);
+#endif
+		for ( ; x < rowbytes; x++)
+		{
+			const UINT8 a = (x < bpp) ? 0 : raw[x - bpp];
+			const UINT8 c = (x < bpp) ? 0 : prev[x - bpp];
+			sub[x] = raw[x] - a;
+			up[x] = raw[x] - prev[x];
+			average[x] = raw[x] - (a + prev[x]) / 2;
+			paeth[x] = raw[x] - paeth_predictor(a, prev[x], c);
+			sums[PNG_PF_None] += abs(INT8(raw[x]));
+			sums[PNG_PF_Sub] += abs(INT8(sub[x]));
+			sums[PNG_PF_Up] += abs(INT8(up[x]));
+			sums[PNG_PF_Average] += abs(INT8(average[x]));
+			sums[PNG_PF_Paeth] += abs(INT8(paeth[x]));
+		}
+
+		/* keep the best, preferring the simpler filter on ties */
+		int best = PNG_PF_None;
+		for (int type = PNG_PF_Sub; type <= PNG_PF_Paeth; type++)
+			if (sums[type] < sums[best])
+				best = type;
+
+		UINT8 *dst = filtered + y * (rowbytes + 1);
+		dst[0] = best;
+		memcpy(dst + 1, (best == PNG_PF_None) ? raw : candidates + best * rowbytes, rowbytes);
+	}
+
+	free(candidates);
+	free(zeroes);
+	free(pnginfo->image);
+	pnginfo->image = filtered;
+	return PNGERR_NONE;
+}
+
+
 /*-------------------------------------------------
     write_png_stream - stream a series of PNG
     chunks to the given file
 -------------------------------------------------*/
 
-static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level)
 {
 	UINT8 tempbuff[16];
 	png_text *text;
@@ -1020,7 +1325,13 @@ static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
-	/* if we wanted to get clever and do filtering, we would do it here */
+	/* filter direct colour images unless they are only being stored; palette indexes don't predict well */
+	if (level != 0 && pnginfo->bit_depth == 8 && (pnginfo->color_type == 2 || pnginfo->color_type == 6))
+	{
+		error = filter_image(pnginfo);
+		if (error != PNGERR_NONE)
+			goto handle_error;
+	}
 
 	/* write the IHDR chunk */
 	put_32bit(tempbuff + 0, pnginfo->width);
@@ -1041,7 +1352,7 @@ static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap
 		goto handle_error;
 
 	/* write a single IDAT chunk */
-	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1));
+	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1), level);
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
@@ -1061,7 +1372,7 @@ handle_error:
 }
 
 
-png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level)
 {
 	png_info pnginfo;
 	png_error error;
@@ -1082,7 +1393,7 @@ png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int
 	}
 
 	/* write the rest of the PNG data */
-	error = write_png_stream(fp, info, bitmap, palette_length, palette);
+	error = write_png_stream(fp, info, bitmap, palette_length, palette, level);
 	if (info == &pnginfo)
 		png_free(&pnginfo);
 	return error;
@@ -1131,7 +1442,7 @@ png_error mng_capture_start(core_file *fp, bitmap_t &bitmap, double rate)
 }
 
 /**
- * @fn  png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+ * @fn  png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level)
  *
  * @brief   Mng capture frame.
  *
@@ -1140,13 +1451,14 @@ png_error mng_capture_start(core_file *fp, bitmap_t &bitmap, double rate)
  * @param [in,out]  bitmap  The bitmap.
  * @param   palette_length  Length of the palette.
  * @param   palette         The palette.
+ * @param   level           The zlib compression level.
  *
  * @return  A png_error.
  */
 
-png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level)
 {
-	return write_png_stream(fp, info, bitmap, palette_length, palette);
+	return write_png_stream(fp, info, bitmap, palette_length, palette, level);
 }
 
 /**
@@ -57,6 +57,9 @@
 #define PNG_PF_Average      3
 #define PNG_PF_Paeth        4
 
+/* Compression level for writing: a zlib level from 1 (fastest) to 9 (smallest), or -1 for zlib's default */
+#define PNG_DEFAULT_COMPRESSION (-1)
+
 /* Error types */
 enum png_error
 {
@@ -124,10 +127,10 @@ png_error png_read_bitmap(core_file *fp, bitmap_argb32 &bitmap);
 png_error png_expand_buffer_8bit(png_info *p);
 
 png_error png_add_text(png_info *pnginfo, const char *keyword, const char *text);
-png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette);
+png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level = PNG_DEFAULT_COMPRESSION);
 
 png_error mng_capture_start(core_file *fp, bitmap_t &bitmap, double rate);
-png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette);
+png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level = PNG_DEFAULT_COMPRESSION);
 png_error mng_capture_stop(core_file *fp);
 
 #endif  /* __PNG_H__ */
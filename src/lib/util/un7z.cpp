@@ -17,6 +17,9 @@
 #include <stdlib.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <vector>
+
 /***************************************************************************
     7Zip Memory / File handling (adapted from 7zfile.c/.h and 7zalloc.c/.h)
 ***************************************************************************/
@@ -161,6 +164,38 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
 /* number of open files to cache */
 #define _7Z_CACHE_SIZE  8
 
+/* decoded bytes kept per archive, not counting the most recently used block */
+#define _7Z_BLOCK_CACHE_BYTES   (64 * 1024 * 1024)
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* a look stream over packed data which has already been read into memory */
+struct _7z_memory_stream
+{
+	ILookInStream   s;
+	const Byte *    data;                   /* packed data */
+	UInt64          base;                   /* archive offset of the packed data */
+	size_t          size;                   /* size of the packed data */
+	size_t          pos;                    /* current position within the packed data */
+};
+
+
+/* a solid block being decoded by _7z_file_decompress_multiple */
+struct _7z_block_work
+{
+	const CSzArEx * db;                     /* archive database */
+	UInt32          index;                  /* folder index of the block */
+	_7z_memory_stream stream;               /* stream over the packed data */
+	Byte *          packed;                 /* packed data read from the archive */
+	Byte *          buffer;                 /* decoded data */
+	size_t          size;                   /* size of the decoded data */
+	SRes            res;                    /* result of decoding */
+	osd_work_item * osd;                    /* work item decoding it, or nullptr */
+};
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -175,6 +210,14 @@ static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
 /* cache management */
 static void free__7z_file(_7z_file *_7z);
 
+/* solid block management */
+static _7z_block *find_block(_7z_file *_7z, UInt32 index);
+static void add_block(_7z_file *_7z, UInt32 index, Byte *buffer, size_t size);
+static SRes decode_block(const CSzArEx *db, UInt32 index, ILookInStream *stream, Byte **buffer, size_t *size, ISzAlloc *alloc);
+static void *decode_block_work(void *param, int threadid);
+static _7z_error copy_file(_7z_file *_7z, int index, const _7z_block *block, void *buffer, UINT32 length);
+static void memory_stream_init(_7z_memory_stream *stream, const Byte *data, UInt64 base, size_t size);
+
 
 /***************************************************************************
     _7Z FILE ACCESS
@@ -349,9 +392,8 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		goto error;
 	}
 
-	new_7z->blockIndex = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
-	new_7z->outBuffer = nullptr; /* it must be 0 before first call for each new archive. */
-	new_7z->outBufferSize = 0;  /* it can have any value before first call (if outBuffer = 0) */
+	for (int blocknum = 0; blocknum < _7Z_BLOCK_CACHE_SIZE; blocknum++)
+		new_7z->blocks[blocknum].index = 0xFFFFFFFF;
 
 	/* make a copy of the filename for caching purposes */
 	string = (char *)malloc(strlen(filename) + 1);
@@ -430,34 +472,390 @@ _7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length)
 	file_error err;
 	SRes res;
 	int index = new_7z->curr_file_idx;
+	UInt32 blockindex = new_7z->db.FileIndexToFolderIndexMap[index];
+
+	/* files without a stream are empty */
+	if (blockindex == 0xFFFFFFFF)
+		return copy_file(new_7z, index, nullptr, buffer, length);
+
+	/* decode the solid block unless we still have it */
+	_7z_block *block = find_block(new_7z, blockindex);
+	if (block == nullptr)
+	{
+		/* make sure the file is open.. */
+		if (new_7z->archiveStream.file._7z_osdfile==nullptr)
+		{
+			new_7z->archiveStream.file._7z_currfpos = 0;
+			err = osd_open(new_7z->filename, OPEN_FLAG_READ, &new_7z->archiveStream.file._7z_osdfile, &new_7z->archiveStream.file._7z_length);
+			if (err != FILERR_NONE)
+				return _7ZERR_FILE_ERROR;
+		}
+
+		Byte *data;
+		size_t size;
+		res = decode_block(&new_7z->db, blockindex, &new_7z->lookStream.s, &data, &size, &new_7z->allocImp);
+		if (res != SZ_OK)
+			return _7ZERR_FILE_ERROR;
+		add_block(new_7z, blockindex, data, size);
+		block = find_block(new_7z, blockindex);
+	}
+
+	return copy_file(new_7z, index, block, buffer, length);
+}
+
+
+/*-------------------------------------------------
+    _7z_file_decompress_multiple - decompress
+    several files from a _7Z; missing solid
+    blocks are read in archive order on this
+    thread and decoded on a work queue
+-------------------------------------------------*/
+
+_7z_error _7z_file_decompress_multiple(_7z_file *_7z, _7z_decompress_request *requests, int count)
+{
+	_7z_error _7zerr = _7ZERR_NONE;
+	int reqnum, worknum;
+
+	/* collect the blocks we don't have yet */
+	std::vector<UInt32> missing;
+	for (reqnum = 0; reqnum < count; reqnum++)
+	{
+		UInt32 blockindex = _7z->db.FileIndexToFolderIndexMap[requests[reqnum].index];
+		if (blockindex != 0xFFFFFFFF && find_block(_7z, blockindex) == nullptr)
+			missing.push_back(blockindex);
+	}
+	std::sort(missing.begin(), missing.end());
+	missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
 
 	/* make sure the file is open.. */
-	if (new_7z->archiveStream.file._7z_osdfile==nullptr)
+	if (!missing.empty() && _7z->archiveStream.file._7z_osdfile == nullptr)
 	{
-		new_7z->archiveStream.file._7z_currfpos = 0;
-		err = osd_open(new_7z->filename, OPEN_FLAG_READ, &new_7z->archiveStream.file._7z_osdfile, &new_7z->archiveStream.file._7z_length);
+		_7z->archiveStream.file._7z_currfpos = 0;
+		file_error err = osd_open(_7z->filename, OPEN_FLAG_READ, &_7z->archiveStream.file._7z_osdfile, &_7z->archiveStream.file._7z_length);
 		if (err != FILERR_NONE)
-			return _7ZERR_FILE_ERROR;
+			missing.clear();
 	}
 
-	size_t offset = 0;
-	size_t outSizeProcessed = 0;
+	/* read the packed data in archive order and queue the blocks for decoding */
+	std::vector<_7z_block_work> work(missing.size());
+	osd_work_queue *queue = (missing.size() > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	for (worknum = 0; worknum < work.size(); worknum++)
+	{
+		_7z_block_work &item = work[worknum];
+		UInt64 base = SzArEx_GetFolderStreamPos(&_7z->db, missing[worknum], 0);
+		UInt64 packsize;
+		UINT32 read_length;
+
+		item.db = &_7z->db;
+		item.index = missing[worknum];
+		item.packed = nullptr;
+		item.buffer = nullptr;
+		item.size = 0;
+		item.osd = nullptr;
+		item.res = SzArEx_GetFolderFullPackSize(&_7z->db, item.index, &packsize);
+		if (item.res != SZ_OK)
+			continue;
+		if ((size_t)packsize != packsize || (UINT32)packsize != packsize)
+		{
+			item.res = SZ_ERROR_MEM;
+			continue;
+		}
+		if (packsize != 0)
+		{
+			item.packed = (Byte *)IAlloc_Alloc(&_7z->allocImp, (size_t)packsize);
+			if (item.packed == nullptr)
+			{
+				item.res = SZ_ERROR_MEM;
+				continue;
+			}
+			if (osd_read(_7z->archiveStream.file._7z_osdfile, item.packed, base, (UINT32)packsize, &read_length) != FILERR_NONE || read_length != packsize)
+			{
+				item.res = SZ_ERROR_READ;
+				continue;
+			}
+		}
+		memory_stream_init(&item.stream, item.packed, base, (size_t)packsize);
+
+		if (queue != nullptr)
+			item.osd = osd_work_item_queue(queue, decode_block_work, &item, 0);
+		if (item.osd == nullptr)
+			decode_block_work(&item, 0);
+	}
+
+	/* wait for the blocks, then keep them */
+	for (worknum = 0; worknum < work.size(); worknum++)
+	{
+		_7z_block_work &item = work[worknum];
+		if (item.osd != nullptr)
+		{
+			osd_work_item_wait(item.osd, 100 * osd_ticks_per_second());
+			osd_work_item_release(item.osd);
+		}
+		IAlloc_Free(&_7z->allocImp, item.packed);
+	}
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
+
+	/* copy out the files; blocks decoded here are used directly, since the cache may not hold them all */
+	for (reqnum = 0; reqnum < count; reqnum++)
+	{
+		_7z_decompress_request &request = requests[reqnum];
+		UInt32 blockindex = _7z->db.FileIndexToFolderIndexMap[request.index];
+		_7z_block decoded;
+		const _7z_block *block = nullptr;
+
+		if (blockindex != 0xFFFFFFFF)
+		{
+			for (worknum = 0; worknum < work.size(); worknum++)
+				if (work[worknum].index == blockindex)
+					break;
+			if (worknum < work.size())
+			{
+				decoded.index = blockindex;
+				decoded.buffer = work[worknum].buffer;
+				decoded.size = work[worknum].size;
+				if (work[worknum].res == SZ_OK)
+					block = &decoded;
+			}
+			else
+				block = find_block(_7z, blockindex);
+		}
+
+		if (blockindex != 0xFFFFFFFF && block == nullptr)
+			request.error = _7ZERR_FILE_ERROR;
+		else
+			request.error = copy_file(_7z, request.index, block, request.buffer, request.length);
+		if (request.error != _7ZERR_NONE && _7zerr == _7ZERR_NONE)
+			_7zerr = request.error;
+	}
+
+	/* hand the decoded blocks over to the cache */
+	for (worknum = 0; worknum < work.size(); worknum++)
+		if (work[worknum].res == SZ_OK)
+			add_block(_7z, work[worknum].index, work[worknum].buffer, work[worknum].size);
+
+	return _7zerr;
+}
+
+
+
+/***************************************************************************
+    SOLID BLOCK MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    find_block - find a decoded solid block and
+    mark it as most recently used
+-------------------------------------------------*/
+
+static _7z_block *find_block(_7z_file *_7z, UInt32 index)
+{
+	for (int blocknum = 0; blocknum < _7Z_BLOCK_CACHE_SIZE; blocknum++)
+	{
+		_7z_block *block = &_7z->blocks[blocknum];
+		if (block->index == index)
+		{
+			block->lastuse = ++_7z->blockuse;
+			return block;
+		}
+	}
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    add_block - take ownership of a decoded solid
+    block, evicting the least recently used ones
+    to stay within the cache limits
+-------------------------------------------------*/
+
+static void add_block(_7z_file *_7z, UInt32 index, Byte *buffer, size_t size)
+{
+	_7z_block *newblock = nullptr;
+	int blocknum;
+
+	/* use an empty slot if there is one, otherwise the least recently used */
+	for (blocknum = 0; blocknum < _7Z_BLOCK_CACHE_SIZE; blocknum++)
+	{
+		_7z_block *block = &_7z->blocks[blocknum];
+		if (newblock == nullptr || (newblock->index != 0xFFFFFFFF && (block->index == 0xFFFFFFFF || block->lastuse < newblock->lastuse)))
+			newblock = block;
+	}
+	IAlloc_Free(&_7z->allocImp, newblock->buffer);
+	newblock->index = index;
+	newblock->buffer = buffer;
+	newblock->size = size;
+	newblock->lastuse = ++_7z->blockuse;
+
+	/* the most recent block is always kept; drop the oldest others while over budget */
+	for (;;)
+	{
+		_7z_block *oldest = nullptr;
+		size_t total = 0;
+		for (blocknum = 0; blocknum < _7Z_BLOCK_CACHE_SIZE; blocknum++)
+		{
+			_7z_block *block = &_7z->blocks[blocknum];
+			if (block->index == 0xFFFFFFFF || block == newblock)
+				continue;
+			total += block->size;
+			if (oldest == nullptr || block->lastuse < oldest->lastuse)
+				oldest = block;
+		}
+		if (total <= _7Z_BLOCK_CACHE_BYTES)
+			break;
+		IAlloc_Free(&_7z->allocImp, oldest->buffer);
+		oldest->index = 0xFFFFFFFF;
+		oldest->buffer = nullptr;
+		oldest->size = 0;
+	}
+}
+
+
+/*-------------------------------------------------
+    decode_block - decode a solid block into a
+    newly allocated buffer
+-------------------------------------------------*/
 
-	res = SzArEx_Extract(&new_7z->db, &new_7z->lookStream.s, index,
-		&new_7z->blockIndex, &new_7z->outBuffer, &new_7z->outBufferSize,
-		&offset, &outSizeProcessed,
-		&new_7z->allocImp, &new_7z->allocTempImp);
+static SRes decode_block(const CSzArEx *db, UInt32 index, ILookInStream *stream, Byte **buffer, size_t *size, ISzAlloc *alloc)
+{
+	CSzFolder *folder = db->db.Folders + index;
+	UInt64 unpacksize = SzFolder_GetUnpackSize(folder);
+
+	*buffer = nullptr;
+	*size = (size_t)unpacksize;
+	if (*size != unpacksize)
+		return SZ_ERROR_MEM;
+	if (*size != 0)
+	{
+		*buffer = (Byte *)IAlloc_Alloc(alloc, *size);
+		if (*buffer == nullptr)
+			return SZ_ERROR_MEM;
+	}
+
+	SRes res = SzFolder_Decode(folder, db->db.PackSizes + db->FolderStartPackStreamIndex[index],
+		stream, SzArEx_GetFolderStreamPos(db, index, 0), *buffer, *size, alloc);
+	if (res == SZ_OK && folder->UnpackCRCDefined && CrcCalc(*buffer, *size) != folder->UnpackCRC)
+		res = SZ_ERROR_CRC;
 
 	if (res != SZ_OK)
-		return _7ZERR_FILE_ERROR;
+	{
+		IAlloc_Free(alloc, *buffer);
+		*buffer = nullptr;
+	}
+	return res;
+}
+
 
-	memcpy(buffer, new_7z->outBuffer + offset, length);
+/*-------------------------------------------------
+    decode_block_work - work queue callback that
+    decodes one block from its packed data
+-------------------------------------------------*/
+
+static void *decode_block_work(void *param, int threadid)
+{
+	_7z_block_work *item = (_7z_block_work *)param;
+	ISzAlloc alloc;
+
+	alloc.Alloc = SZipAlloc;
+	alloc.Free = SZipFree;
+	item->res = decode_block(item->db, item->index, &item->stream.s, &item->buffer, &item->size, &alloc);
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    copy_file - copy one file out of its decoded
+    solid block, checking its CRC
+-------------------------------------------------*/
+
+static _7z_error copy_file(_7z_file *_7z, int index, const _7z_block *block, void *buffer, UINT32 length)
+{
+	const CSzFileItem *file = _7z->db.db.Files + index;
+	size_t offset = 0;
+
+	/* files without a stream have no data */
+	if (block == nullptr)
+		return (file->Size == 0) ? _7ZERR_NONE : _7ZERR_FILE_CORRUPT;
 
+	/* files are stored back to back within their block */
+	for (UInt32 filenum = _7z->db.FolderStartFileIndex[block->index]; filenum < index; filenum++)
+		offset += (size_t)_7z->db.db.Files[filenum].Size;
+	if (offset + file->Size > block->size)
+		return _7ZERR_FILE_CORRUPT;
+	if (file->CrcDefined && CrcCalc(block->buffer + offset, (size_t)file->Size) != file->Crc)
+		return _7ZERR_FILE_ERROR;
+	if (length > file->Size)
+		return _7ZERR_FILE_TRUNCATED;
+
+	memcpy(buffer, block->buffer + offset, length);
 	return _7ZERR_NONE;
 }
 
 
 
+/***************************************************************************
+    MEMORY STREAM
+***************************************************************************/
+
+static SRes MemoryStream_Look(void *pp, const void **buf, size_t *size)
+{
+	_7z_memory_stream *p = (_7z_memory_stream *)pp;
+	if (*size > p->size - p->pos)
+		*size = p->size - p->pos;
+	*buf = p->data + p->pos;
+	return SZ_OK;
+}
+
+static SRes MemoryStream_Skip(void *pp, size_t offset)
+{
+	_7z_memory_stream *p = (_7z_memory_stream *)pp;
+	if (offset > p->size - p->pos)
+		return SZ_ERROR_READ;
+	p->pos += offset;
+	return SZ_OK;
+}
+
+static SRes MemoryStream_Read(void *pp, void *buf, size_t *size)
+{
+	_7z_memory_stream *p = (_7z_memory_stream *)pp;
+	if (*size > p->size - p->pos)
+		*size = p->size - p->pos;
+	memcpy(buf, p->data + p->pos, *size);
+	p->pos += *size;
+	return SZ_OK;
+}
+
+static SRes MemoryStream_Seek(void *pp, Int64 *pos, ESzSeek origin)
+{
+	_7z_memory_stream *p = (_7z_memory_stream *)pp;
+	Int64 newpos = *pos;
+	if (origin == SZ_SEEK_SET)
+		newpos -= p->base;
+	else if (origin == SZ_SEEK_CUR)
+		newpos += p->pos;
+	else
+		newpos += p->size;
+	if (newpos < 0 || newpos > p->size)
+		return SZ_ERROR_READ;
+	p->pos = (size_t)newpos;
+	*pos = p->base + p->pos;
+	return SZ_OK;
+}
+
+static void memory_stream_init(_7z_memory_stream *stream, const Byte *data, UInt64 base, size_t size)
+{
+	stream->s.Look = MemoryStream_Look;
+	stream->s.Skip = MemoryStream_Skip;
+	stream->s.Read = MemoryStream_Read;
+	stream->s.Seek = MemoryStream_Seek;
+	stream->data = data;
+	stream->base = base;
+	stream->size = size;
+	stream->pos = 0;
+}
+
+
+
 /***************************************************************************
     CACHE MANAGEMENT
 ***************************************************************************/
@@ -485,7 +883,8 @@ static void free__7z_file(_7z_file *_7z)
 			free((void *)_7z->filename);
 
 
-		if (_7z->outBuffer) IAlloc_Free(&_7z->allocImp, _7z->outBuffer);
+		for (int blocknum = 0; blocknum < _7Z_BLOCK_CACHE_SIZE; blocknum++)
+			if (_7z->blocks[blocknum].buffer) IAlloc_Free(&_7z->allocImp, _7z->blocks[blocknum].buffer);
 		if (_7z->inited) SzArEx_Free(&_7z->db, &_7z->allocImp);
 
 
@@ -69,6 +69,9 @@ void FileOutStream_CreateVTable(CFileOutStream *p);
 ***************************************************************************/
 
 
+/* number of decoded solid blocks kept per archive */
+#define _7Z_BLOCK_CACHE_SIZE    16
+
 /* Error types */
 enum _7z_error
 {
@@ -89,6 +92,26 @@ enum _7z_error
     TYPE DEFINITIONS
 ***************************************************************************/
 
+/* a decoded solid block */
+struct _7z_block
+{
+	UInt32          index;                  /* folder index of the block, or 0xFFFFFFFF if empty */
+	Byte *          buffer;                 /* decoded data */
+	size_t          size;                   /* size of the decoded data */
+	UINT32          lastuse;                /* value of blockuse when last accessed */
+};
+
+
+/* describes one file for _7z_file_decompress_multiple */
+struct _7z_decompress_request
+{
+	int             index;                  /* file index, as returned by _7z_search_crc_match */
+	void *          buffer;                 /* buffer receiving the data */
+	UINT32          length;                 /* length of the buffer */
+	_7z_error       error;                  /* result of decompressing this file */
+};
+
+
 /* describes an open _7Z file */
 struct  _7z_file
 {
@@ -106,10 +129,9 @@ struct  _7z_file
 	ISzAlloc allocTempImp;
 	bool inited;
 
-	// cached stuff for solid blocks
-	UInt32 blockIndex;// = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
-	Byte *outBuffer;// = 0; /* it must be 0 before first call for each new archive. */
-	size_t outBufferSize;// = 0;  /* it can have any value before first call (if outBuffer = 0) */
+	// cached solid blocks, least recently used is evicted first
+	_7z_block blocks[_7Z_BLOCK_CACHE_SIZE];
+	UINT32 blockuse;
 };
 
 
@@ -139,5 +161,8 @@ int _7z_search_crc_match(_7z_file *new_7z, UINT32 crc, const char *search_filena
 /* decompress the most recently found file in the _7Z */
 _7z_error _7z_file_decompress(_7z_file *_7z, void *buffer, UINT32 length);
 
+/* decompress several files from the _7Z, decoding the solid blocks they need in parallel; returns the first error */
+_7z_error _7z_file_decompress_multiple(_7z_file *_7z, _7z_decompress_request *requests, int count);
+
 
 #endif  /* __UN_7Z_H__ */
@@ -21,8 +21,11 @@
     CONSTANTS
 ***************************************************************************/
 
-/* number of open files to cache */
-#define ZIP_CACHE_SIZE  8
+/* number of closed ZIP files whose central directories are kept */
+#define ZIP_CACHE_SIZE  64
+
+/* number of most recently closed ZIP files that also keep their OSD file open */
+#define ZIP_OPEN_HANDLES    8
 
 /* offsets in end of central directory structure */
 #define ZIPESIG         0x00
@@ -130,6 +133,20 @@ static inline UINT32 read_dword(UINT8 *buf)
 
 
 
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* a member being inflated by zip_file_decompress_multiple */
+struct zip_inflate_work
+{
+	zip_decompress_request *request;        /* the request being worked on */
+	UINT8 *         compressed;             /* the member's compressed data */
+	osd_work_item * osd;                    /* work item inflating it, or nullptr */
+};
+
+
+
 /***************************************************************************
     GLOBAL VARIABLES
 ***************************************************************************/
@@ -148,11 +165,14 @@ static void free_zip_file(zip_file *zip);
 
 /* ZIP file parsing */
 static zip_error read_ecd(zip_file *zip);
-static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset);
+static zip_error check_header(zip_file *zip, const zip_file_header *header, UINT32 length);
+static zip_error get_compressed_data_offset(zip_file *zip, const zip_file_header *header, UINT32 index, UINT64 *offset);
 
 /* decompression interfaces */
-static zip_error decompress_data_type_0(zip_file *zip, UINT64 offset, void *buffer, UINT32 length);
-static zip_error decompress_data_type_8(zip_file *zip, UINT64 offset, void *buffer, UINT32 length);
+static zip_error decompress_data_type_0(zip_file *zip, const zip_file_header *header, UINT64 offset, void *buffer, UINT32 length);
+static zip_error decompress_data_type_8(zip_file *zip, const zip_file_header *header, UINT64 offset, void *buffer, UINT32 length);
+static zip_error inflate_data(const UINT8 *source, UINT32 sourcelength, void *buffer, UINT32 length);
+static void *inflate_request(void *param, int threadid);
 
 
 
@@ -243,6 +263,14 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 		goto error;
 	}
 
+	/* allocate the table of member data offsets, filled in as members are decompressed */
+	newzip->data_offsets = (UINT64 *)calloc(newzip->ecd.cd_total_entries + 1, sizeof(newzip->data_offsets[0]));
+	if (newzip->data_offsets == nullptr)
+	{
+		ziperr = ZIPERR_OUT_OF_MEMORY;
+		goto error;
+	}
+
 	/* make a copy of the filename for caching purposes */
 	string = (char *)malloc(strlen(filename) + 1);
 	if (string == nullptr)
@@ -263,7 +291,8 @@ error:
 
 /*-------------------------------------------------
     zip_file_close - close a ZIP file and add it
-    to the cache
+    to the cache; only the most recently used
+    files keep their OSD file open
 -------------------------------------------------*/
 
 /**
@@ -278,11 +307,6 @@ void zip_file_close(zip_file *zip)
 {
 	int cachenum;
 
-	/* close the open files */
-	if (zip->file != nullptr)
-		osd_close(zip->file);
-	zip->file = nullptr;
-
 	/* find the first NULL entry in the cache */
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 		if (zip_cache[cachenum] == nullptr)
@@ -296,6 +320,13 @@ void zip_file_close(zip_file *zip)
 	if (cachenum != 0)
 		memmove(&zip_cache[1], &zip_cache[0], cachenum * sizeof(zip_cache[0]));
 	zip_cache[0] = zip;
+
+	/* the file that just dropped out of the most recent set gives up its handle */
+	if (cachenum >= ZIP_OPEN_HANDLES && zip_cache[ZIP_OPEN_HANDLES]->file != nullptr)
+	{
+		osd_close(zip_cache[ZIP_OPEN_HANDLES]->file);
+		zip_cache[ZIP_OPEN_HANDLES]->file = nullptr;
+	}
 }
 
 
@@ -346,8 +377,9 @@ void zip_file_cache_clear(void)
 
 const zip_file_header *zip_file_first_file(zip_file *zip)
 {
-	/* reset the position and go from there */
+	/* reset the position and go from there; the index wraps to 0 on the first file */
 	zip->cd_pos = 0;
+	zip->cd_index = ~0;
 	return zip_file_next_file(zip);
 }
 
@@ -415,6 +447,7 @@ const zip_file_header *zip_file_next_file(zip_file *zip)
 
 	/* advance the position */
 	zip->cd_pos += zip->header.rawlength;
+	zip->cd_index++;
 	return &zip->header;
 }
 
@@ -441,16 +474,13 @@ zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length)
 	zip_error ziperr;
 	UINT64 offset;
 
-	/* if we don't have enough buffer, error */
-	if (length < zip->header.uncompressed_length)
-		return ZIPERR_BUFFER_TOO_SMALL;
-
-	/* make sure the info in the header aligns with what we know */
-	if (zip->header.start_disk_number != zip->ecd.disk_number)
-		return ZIPERR_UNSUPPORTED;
+	/* make sure we can handle this file */
+	ziperr = check_header(zip, &zip->header, length);
+	if (ziperr != ZIPERR_NONE)
+		return ziperr;
 
 	/* get the compressed data offset */
-	ziperr = get_compressed_data_offset(zip, &offset);
+	ziperr = get_compressed_data_offset(zip, &zip->header, zip->cd_index, &offset);
 	if (ziperr != ZIPERR_NONE)
 		return ziperr;
 
@@ -458,11 +488,11 @@ zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length)
 	switch (zip->header.compression)
 	{
 		case 0:
-			ziperr = decompress_data_type_0(zip, offset, buffer, length);
+			ziperr = decompress_data_type_0(zip, &zip->header, offset, buffer, length);
 			break;
 
 		case 8:
-			ziperr = decompress_data_type_8(zip, offset, buffer, length);
+			ziperr = decompress_data_type_8(zip, &zip->header, offset, buffer, length);
 			break;
 
 		default:
@@ -473,6 +503,107 @@ zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length)
 }
 
 
+/*-------------------------------------------------
+    zip_file_decompress_multiple - decompress
+    several files from a ZIP; the compressed
+    data is read on this thread and inflated on
+    a work queue as soon as it is in memory
+-------------------------------------------------*/
+
+/**
+ * @fn  zip_error zip_file_decompress_multiple(zip_file *zip, zip_decompress_request *requests, int count)
+ *
+ * @brief   Zip file decompress multiple.
+ *
+ * @param [in,out]  zip         If non-null, the zip.
+ * @param [in,out]  requests    If non-null, the requests.
+ * @param   count               Number of requests.
+ *
+ * @return  The first error of any request, or ZIPERR_NONE.
+ */
+
+zip_error zip_file_decompress_multiple(zip_file *zip, zip_decompress_request *requests, int count)
+{
+	zip_error ziperr = ZIPERR_NONE;
+	int reqnum;
+
+	/* allocate the work items */
+	zip_inflate_work *work = (zip_inflate_work *)calloc(count, sizeof(work[0]));
+	if (work == nullptr)
+		return ZIPERR_OUT_OF_MEMORY;
+	osd_work_queue *queue = (count > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+
+	for (reqnum = 0; reqnum < count; reqnum++)
+	{
+		zip_decompress_request &request = requests[reqnum];
+		zip_inflate_work &item = work[reqnum];
+		UINT32 read_length;
+		UINT64 offset;
+
+		/* check the header and find the data */
+		request.error = check_header(zip, &request.header, request.length);
+		if (request.error == ZIPERR_NONE)
+			request.error = get_compressed_data_offset(zip, &request.header, request.index, &offset);
+		if (request.error != ZIPERR_NONE)
+			continue;
+
+		/* stored data needs nothing more than reading */
+		if (request.header.compression != 8)
+		{
+			if (request.header.compression == 0)
+				request.error = decompress_data_type_0(zip, &request.header, offset, request.buffer, request.length);
+			else
+				request.error = ZIPERR_UNSUPPORTED;
+			continue;
+		}
+		if (request.header.version_needed > 0x14)
+		{
+			request.error = ZIPERR_UNSUPPORTED;
+			continue;
+		}
+
+		/* read all the compressed data, plus the dummy byte inflate_data wants */
+		item.request = &request;
+		item.compressed = (UINT8 *)malloc(request.header.compressed_length + 1);
+		if (item.compressed == nullptr)
+		{
+			request.error = ZIPERR_OUT_OF_MEMORY;
+			continue;
+		}
+		item.compressed[request.header.compressed_length] = 0;
+		file_error filerr = osd_read(zip->file, item.compressed, offset, request.header.compressed_length, &read_length);
+		if (filerr != FILERR_NONE || read_length != request.header.compressed_length)
+		{
+			request.error = (filerr == FILERR_NONE) ? ZIPERR_FILE_TRUNCATED : ZIPERR_FILE_ERROR;
+			continue;
+		}
+
+		/* hand it off; without a queue, inflate it right here */
+		if (queue != nullptr)
+			item.osd = osd_work_item_queue(queue, inflate_request, &item, 0);
+		if (item.osd == nullptr)
+			inflate_request(&item, 0);
+	}
+
+	/* wait for everything to finish, and clean up */
+	for (reqnum = 0; reqnum < count; reqnum++)
+	{
+		if (work[reqnum].osd != nullptr)
+		{
+			osd_work_item_wait(work[reqnum].osd, 100 * osd_ticks_per_second());
+			osd_work_item_release(work[reqnum].osd);
+		}
+		free(work[reqnum].compressed);
+		if (ziperr == ZIPERR_NONE)
+			ziperr = requests[reqnum].error;
+	}
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
+	free(work);
+	return ziperr;
+}
+
+
 
 /***************************************************************************
     CACHE MANAGEMENT
@@ -503,6 +634,8 @@ static void free_zip_file(zip_file *zip)
 			free(zip->ecd.raw);
 		if (zip->cd != nullptr)
 			free(zip->cd);
+		if (zip->data_offsets != nullptr)
+			free(zip->data_offsets);
 		free(zip);
 	}
 }
@@ -596,23 +729,57 @@ static zip_error read_ecd(zip_file *zip)
 }
 
 
+/*-------------------------------------------------
+    check_header - make sure we can decompress
+    the file described by a header
+-------------------------------------------------*/
+
+/**
+ * @fn  static zip_error check_header(zip_file *zip, const zip_file_header *header, UINT32 length)
+ *
+ * @brief   Checks that a file can be decompressed into a buffer.
+ *
+ * @param [in,out]  zip     If non-null, the zip.
+ * @param   header          The file header.
+ * @param   length          The length of the buffer.
+ *
+ * @return  A zip_error.
+ */
+
+static zip_error check_header(zip_file *zip, const zip_file_header *header, UINT32 length)
+{
+	/* if we don't have enough buffer, error */
+	if (length < header->uncompressed_length)
+		return ZIPERR_BUFFER_TOO_SMALL;
+
+	/* make sure the info in the header aligns with what we know */
+	if (header->start_disk_number != zip->ecd.disk_number)
+		return ZIPERR_UNSUPPORTED;
+
+	return ZIPERR_NONE;
+}
+
+
 /*-------------------------------------------------
     get_compressed_data_offset - return the
-    offset of the compressed data
+    offset of the compressed data, remembering
+    it for the next time the file is read
 -------------------------------------------------*/
 
 /**
- * @fn  static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset)
+ * @fn  static zip_error get_compressed_data_offset(zip_file *zip, const zip_file_header *header, UINT32 index, UINT64 *offset)
  *
  * @brief   Gets compressed data offset.
  *
  * @param [in,out]  zip     If non-null, the zip.
+ * @param   header          The file header.
+ * @param   index           The index of the file in the central directory.
  * @param [in,out]  offset  If non-null, the offset.
  *
  * @return  The compressed data offset.
  */
 
-static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset)
+static zip_error get_compressed_data_offset(zip_file *zip, const zip_file_header *header, UINT32 index, UINT64 *offset)
 {
 	file_error error;
 	UINT32 read_length;
@@ -625,16 +792,26 @@ static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset)
 			return ZIPERR_FILE_ERROR;
 	}
 
+	/* use the offset from last time if we have it */
+	if (index < zip->ecd.cd_total_entries && zip->data_offsets[index] != 0)
+	{
+		*offset = zip->data_offsets[index];
+		return ZIPERR_NONE;
+	}
+
 	/* now go read the fixed-sized part of the local file header */
-	error = osd_read(zip->file, zip->buffer, zip->header.local_header_offset, ZIPNAME, &read_length);
+	UINT8 local[ZIPNAME];
+	error = osd_read(zip->file, local, header->local_header_offset, ZIPNAME, &read_length);
 	if (error != FILERR_NONE || read_length != ZIPNAME)
 		return (error == FILERR_NONE) ? ZIPERR_FILE_TRUNCATED : ZIPERR_FILE_ERROR;
 
 	/* compute the final offset */
-	*offset = zip->header.local_header_offset + ZIPNAME;
-	*offset += read_word(zip->buffer + ZIPFNLN);
-	*offset += read_word(zip->buffer + ZIPXTRALN);
+	*offset = header->local_header_offset + ZIPNAME;
+	*offset += read_word(local + ZIPFNLN);
+	*offset += read_word(local + ZIPXTRALN);
 
+	if (index < zip->ecd.cd_total_entries)
+		zip->data_offsets[index] = *offset;
 	return ZIPERR_NONE;
 }
 
@@ -650,11 +827,12 @@ static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset)
 -------------------------------------------------*/
 
 /**
- * @fn  static zip_error decompress_data_type_0(zip_file *zip, UINT64 offset, void *buffer, UINT32 length)
+ * @fn  static zip_error decompress_data_type_0(zip_file *zip, const zip_file_header *header, UINT64 offset, void *buffer, UINT32 length)
  *
  * @brief   Decompress the data type 0.
  *
  * @param [in,out]  zip     If non-null, the zip.
+ * @param   header          The file header.
  * @param   offset          The offset.
  * @param [in,out]  buffer  If non-null, the buffer.
  * @param   length          The length.
@@ -662,16 +840,16 @@ static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset)
  * @return  A zip_error.
  */
 
-static zip_error decompress_data_type_0(zip_file *zip, UINT64 offset, void *buffer, UINT32 length)
+static zip_error decompress_data_type_0(zip_file *zip, const zip_file_header *header, UINT64 offset, void *buffer, UINT32 length)
 {
 	file_error filerr;
 	UINT32 read_length;
 
 	/* the data is uncompressed; just read it */
-	filerr = osd_read(zip->file, buffer, offset, zip->header.compressed_length, &read_length);
+	filerr = osd_read(zip->file, buffer, offset, header->compressed_length, &read_length);
 	if (filerr != FILERR_NONE)
 		return ZIPERR_FILE_ERROR;
-	else if (read_length != zip->header.compressed_length)
+	else if (read_length != header->compressed_length)
 		return ZIPERR_FILE_TRUNCATED;
 	else
 		return ZIPERR_NONE;
@@ -684,11 +862,12 @@ static zip_error decompress_data_type_0(zip_file *zip, UINT64 offset, void *buff
 -------------------------------------------------*/
 
 /**
- * @fn  static zip_error decompress_data_type_8(zip_file *zip, UINT64 offset, void *buffer, UINT32 length)
+ * @fn  static zip_error decompress_data_type_8(zip_file *zip, const zip_file_header *header, UINT64 offset, void *buffer, UINT32 length)
  *
  * @brief   Decompress the data type 8.
  *
  * @param [in,out]  zip     If non-null, the zip.
+ * @param   header          The file header.
  * @param   offset          The offset.
  * @param [in,out]  buffer  If non-null, the buffer.
  * @param   length          The length.
@@ -696,16 +875,16 @@ static zip_error decompress_data_type_0(zip_file *zip, UINT64 offset, void *buff
  * @return  A zip_error.
  */
 
-static zip_error decompress_data_type_8(zip_file *zip, UINT64 offset, void *buffer, UINT32 length)
+static zip_error decompress_data_type_8(zip_file *zip, const zip_file_header *header, UINT64 offset, void *buffer, UINT32 length)
 {
-	UINT32 input_remaining = zip->header.compressed_length;
+	UINT32 input_remaining = header->compressed_length;
 	UINT32 read_length;
 	z_stream stream;
 	int filerr;
 	int zerr;
 
 	/* make sure we don't need a newer mechanism */
-	if (zip->header.version_needed > 0x14)
+	if (header->version_needed > 0x14)
 		return ZIPERR_UNSUPPORTED;
 
 	/* reset the stream */
@@ -768,3 +947,72 @@ static zip_error decompress_data_type_8(zip_file *zip, UINT64 offset, void *buff
 
 	return ZIPERR_NONE;
 }
+
+
+/*-------------------------------------------------
+    inflate_data - inflate type 8 data that is
+    already in memory
+-------------------------------------------------*/
+
+/**
+ * @fn  static zip_error inflate_data(const UINT8 *source, UINT32 sourcelength, void *buffer, UINT32 length)
+ *
+ * @brief   Inflate data held in memory.
+ *
+ * @param   source          The compressed data, followed by one spare byte.
+ * @param   sourcelength    The length of the compressed data.
+ * @param [in,out]  buffer  If non-null, the buffer.
+ * @param   length          The length.
+ *
+ * @return  A zip_error.
+ */
+
+static zip_error inflate_data(const UINT8 *source, UINT32 sourcelength, void *buffer, UINT32 length)
+{
+	z_stream stream;
+	int zerr;
+
+	/* reset the stream; like decompress_data_type_8, add a dummy byte at the end */
+	memset(&stream, 0, sizeof(stream));
+	stream.next_in = const_cast<Bytef *>(source);
+	stream.avail_in = sourcelength + 1;
+	stream.next_out = (Bytef *)buffer;
+	stream.avail_out = length;
+
+	/* inflate it all in one go */
+	zerr = inflateInit2(&stream, -MAX_WBITS);
+	if (zerr != Z_OK)
+		return ZIPERR_DECOMPRESS_ERROR;
+	zerr = inflate(&stream, Z_FINISH);
+	inflateEnd(&stream);
+
+	/* if anything looks funny, report an error */
+	if (zerr != Z_STREAM_END || stream.avail_out > 0)
+		return ZIPERR_DECOMPRESS_ERROR;
+	return ZIPERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    inflate_request - work item callback for
+    zip_file_decompress_multiple
+-------------------------------------------------*/
+
+/**
+ * @fn  static void *inflate_request(void *param, int threadid)
+ *
+ * @brief   Inflate one member on a work queue thread.
+ *
+ * @param [in,out]  param   The zip_inflate_work.
+ * @param   threadid        The thread.
+ *
+ * @return  null.
+ */
+
+static void *inflate_request(void *param, int threadid)
+{
+	zip_inflate_work *work = (zip_inflate_work *)param;
+	zip_decompress_request *request = work->request;
+	request->error = inflate_data(work->compressed, request->header.compressed_length, request->buffer, request->length);
+	return nullptr;
+}
@@ -88,6 +88,17 @@ struct zip_ecd
 };
 
 
+/* describes one member for zip_file_decompress_multiple */
+struct zip_decompress_request
+{
+	zip_file_header header;                 /* copy of the header returned by zip_file_first_file/zip_file_next_file */
+	UINT32          index;                  /* the member's index in the central directory (zip->cd_index) */
+	void *          buffer;                 /* buffer receiving the data */
+	UINT32          length;                 /* length of the buffer */
+	zip_error       error;                  /* result of decompressing this member */
+};
+
+
 /* describes an open ZIP file */
 struct zip_file
 {
@@ -99,7 +110,9 @@ struct zip_file
 
 	UINT8 *         cd;                     /* central directory raw data */
 	UINT32          cd_pos;                 /* position in central directory */
+	UINT32          cd_index;               /* index of the current file header */
 	zip_file_header header;                 /* current file header */
+	UINT64 *        data_offsets;           /* offsets of member data, or 0 if not yet known */
 
 	UINT8           buffer[ZIP_DECOMPRESS_BUFSIZE]; /* buffer for decompression */
 };
@@ -134,5 +147,8 @@ const zip_file_header *zip_file_next_file(zip_file *zip);
 /* decompress the most recently found file in the ZIP */
 zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length);
 
+/* decompress several files from the ZIP, inflating them in parallel; returns the first error */
+zip_error zip_file_decompress_multiple(zip_file *zip, zip_decompress_request *requests, int count);
+
 
 #endif  /* __UNZIP_H__ */
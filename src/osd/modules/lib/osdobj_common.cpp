@@ -120,6 +120,7 @@ const options_entry osd_options::s_option_entries[] =
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD SOUND OPTIONS" },
 	{ OSDOPTION_SOUND,                        OSDOPTVAL_AUTO,   OPTION_STRING,    "sound output method: " },
 	{ OSDOPTION_AUDIO_LATENCY "(0.1-5.0)",    "2.0",            OPTION_FLOAT,     "set audio latency (increase to reduce glitches, decrease for responsiveness)" },
+	{ OSDOPTION_AUDIO_ADAPTIVE,               "0",              OPTION_BOOLEAN,   "shrink the audio buffer to the smallest size that avoids underflows" },
 
 #ifdef SDLMAME_MACOSX
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "CoreAudio-SPECIFIC OPTIONS" },
@@ -414,6 +415,19 @@ void osd_common_t::update_audio_stream(const INT16 *buffer, int samples_this_fra
 }
 
 
+//-------------------------------------------------
+//  audio_buffer_fill - return how full the sound
+//  module's buffer is, from 0 (about to run dry)
+//  through 0.5 (where it wants to be) to 1 (about
+//  to overflow), or a negative value if unknown
+//-------------------------------------------------
+
+float osd_common_t::audio_buffer_fill()
+{
+	return (m_sound != nullptr) ? m_sound->buffer_fill() : -1.0f;
+}
+
+
 //-------------------------------------------------
 //  set_mastervolume - set the system volume
 //-------------------------------------------------
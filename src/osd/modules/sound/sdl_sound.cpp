@@ -47,11 +47,25 @@ public:
 	// number of samples per SDL callback
 	static const int SDL_XFER_SAMPLES = 512;
 
+	// buffer fill histogram: 5ms buckets, the last one catching everything beyond
+	static const int LEAD_HISTOGRAM_BUCKETS = 21;
+	static const int LEAD_HISTOGRAM_MS = 5;
+
+	// adaptive buffering: updates without an underflow before we try a smaller queue
+	static const int ADAPT_STABLE_UPDATES = 150;
+
 	sound_sdl()
 	: osd_module(OSD_SOUND_PROVIDER, "sdl"), sound_module(),
 		stream_in_initialized(0),
 		stream_loop(0),
-		attenuation(0)
+		attenuation(0),
+		adaptive(false),
+		stream_target(0),
+		stable_updates(0),
+		buffer_underflows(0),
+		buffer_overflows(0),
+		callback_underflows(0),
+		last_callback_underflows(0)
 	{
 		sdl_xfer_samples = SDL_XFER_SAMPLES;
 	}
@@ -64,6 +78,7 @@ public:
 
 	virtual void update_audio_stream(bool is_throttled, const INT16 *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual float buffer_fill() override;
 
 private:
 	int lock_buffer(bool is_throttled, long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2);
@@ -72,6 +87,9 @@ private:
 	void copy_sample_data(bool is_throttled, const INT16 *data, int bytes_to_copy);
 	int sdl_create_buffers(void);
 	void sdl_destroy_buffers(void);
+	void adapt_buffer(bool underflowed, int write_position, int &stream_in);
+	void record_lead(int lead, int samples_this_frame);
+	double bytes_to_ms(double bytes) { return bytes * 1000.0 / (sample_rate() * 2 * sizeof(INT16)); }
 
 	int sdl_xfer_samples;
 	int stream_in_initialized;
@@ -86,11 +104,25 @@ private:
 	UINT32           stream_buffer_size;
 	UINT32           stream_buffer_in;
 
+	// adaptive buffering
+	bool             adaptive;
+	UINT32           stream_target;     // bytes to keep queued beyond the write position
+	int              stable_updates;    // updates since the last underflow
+
 	// buffer over/underflow counts
 	int              buffer_underflows;
 	int              buffer_overflows;
-
-
+	volatile INT32   callback_underflows;
+	INT32            last_callback_underflows;
+
+	// buffer fill statistics, in bytes queued ahead of the play cursor
+	UINT32           lead_histogram[LEAD_HISTOGRAM_BUCKETS];
+	UINT64           lead_total;
+	UINT64           frame_samples_total;
+	UINT32           lead_count;
+	int              lead_min;
+	int              lead_max;
+	int              lead_last;
 };
 
 
@@ -262,7 +294,11 @@ void sound_sdl::update_audio_stream(bool is_throttled, const INT16 *buffer, int
 
 		if (!stream_in_initialized)
 		{
-			stream_in = stream_buffer_in = (write_position + stream_buffer_size) / 2;
+			// in adaptive mode, start with a small queue and let it grow
+			if (adaptive)
+				stream_in = stream_buffer_in = write_position + stream_target;
+			else
+				stream_in = stream_buffer_in = (write_position + stream_buffer_size) / 2;
 
 			if (LOG_SOUND)
 			{
@@ -286,15 +322,21 @@ void sound_sdl::update_audio_stream(bool is_throttled, const INT16 *buffer, int
 			//    <------pp---wp---si--------------->
 
 			// if we're between play and write positions, then bump forward, but only in full chunks
+			bool underflowed = false;
 			while (stream_in < write_position)
 			{
 				if (LOG_SOUND)
 					fprintf(sound_log, "Underflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
 
 				buffer_underflows++;
+				underflowed = true;
 				stream_in += bytes_this_frame;
 			}
 
+			// resize the queue if we're adapting
+			if (adaptive)
+				adapt_buffer(underflowed, write_position, stream_in);
+
 			// if we're going to overlap the play position, just skip this chunk
 			if (stream_in + bytes_this_frame > play_position + stream_buffer_size)
 			{
@@ -306,6 +348,9 @@ void sound_sdl::update_audio_stream(bool is_throttled, const INT16 *buffer, int
 			}
 		}
 
+		// account for how much is queued ahead of the play cursor
+		record_lead(stream_in - play_position, samples_this_frame);
+
 		if (stream_in >= stream_buffer_size)
 		{
 			stream_in -= stream_buffer_size;
@@ -324,6 +369,82 @@ void sound_sdl::update_audio_stream(bool is_throttled, const INT16 *buffer, int
 
 
 
+//============================================================
+//  adapt_buffer
+//============================================================
+
+void sound_sdl::adapt_buffer(bool underflowed, int write_position, int &stream_in)
+{
+	UINT32 xfer_bytes = sdl_xfer_samples * sizeof(INT16) * 2;
+	UINT32 max_target = stream_buffer_size / 2;
+
+	// the SDL callback running dry counts as an underflow too
+	INT32 callback_count = callback_underflows;
+	if (callback_count != last_callback_underflows)
+		underflowed = true;
+	last_callback_underflows = callback_count;
+
+	// grow quickly after an underflow, shrink slowly once things have been stable
+	if (underflowed)
+	{
+		stream_target = MIN(stream_target + 2 * xfer_bytes, max_target);
+		stable_updates = 0;
+	}
+	else if (++stable_updates >= ADAPT_STABLE_UPDATES)
+	{
+		stable_updates = 0;
+		if (stream_target > xfer_bytes)
+			stream_target -= xfer_bytes;
+	}
+
+	// if we're queued well beyond the target, drop back by at most one transfer
+	int excess = stream_in - write_position - (int)stream_target;
+	if (excess > (int)xfer_bytes)
+	{
+		stream_in -= MIN(excess / 2, (int)xfer_bytes) & ~3;
+
+		// if that took us back across the end of the buffer, we're no longer looped
+		if (stream_in < (int)stream_buffer_size)
+			stream_loop = 0;
+	}
+}
+
+
+//============================================================
+//  record_lead
+//============================================================
+
+void sound_sdl::record_lead(int lead, int samples_this_frame)
+{
+	int bucket = MIN((int)(bytes_to_ms(lead) / LEAD_HISTOGRAM_MS), LEAD_HISTOGRAM_BUCKETS - 1);
+	lead_histogram[MAX(bucket, 0)]++;
+	lead_total += lead;
+	frame_samples_total += samples_this_frame;
+	lead_min = (lead_count == 0) ? lead : MIN(lead_min, lead);
+	lead_max = (lead_count == 0) ? lead : MAX(lead_max, lead);
+	lead_last = lead;
+	lead_count++;
+}
+
+
+//============================================================
+//  buffer_fill
+//============================================================
+
+float sound_sdl::buffer_fill()
+{
+	if (sample_rate() == 0 || !stream_in_initialized || lead_count == 0)
+		return -1.0f;
+
+	// below the write position we underflow; the target is either the adaptive
+	// queue size or halfway to the end of the buffer
+	float write_offset = (sample_rate() / 50) * sizeof(INT16) * 2;
+	float center = adaptive ? write_offset + stream_target : (write_offset + stream_buffer_size) / 2;
+	float fill = 0.5f * (lead_last - write_offset) / (center - write_offset);
+	return MAX(0.0f, MIN(fill, 1.0f));
+}
+
+
 //============================================================
 //  set_mastervolume
 //============================================================
@@ -356,6 +477,7 @@ static void sdl_callback(void *userdata, Uint8 *stream, int len)
 
 	if (sb_in < (thiz->stream_playpos+len))
 	{
+		thiz->callback_underflows++;
 		if (LOG_SOUND)
 			fprintf(sound_log, "Underflow at sdl_callback: SPP=%d SBI=%d(%d) Len=%d\n", (int)thiz->stream_playpos, (int)sb_in, (int)thiz->stream_buffer_in, (int)len);
 
@@ -428,6 +550,14 @@ int sound_sdl::init(const osd_options &options)
 		stream_in_initialized = 0;
 		stream_loop = 0;
 
+		// reset the statistics
+		buffer_underflows = buffer_overflows = 0;
+		callback_underflows = last_callback_underflows = 0;
+		memset(lead_histogram, 0, sizeof(lead_histogram));
+		lead_total = frame_samples_total = 0;
+		lead_count = 0;
+		lead_min = lead_max = lead_last = 0;
+
 		// set up the audio specs
 		aspec.freq = sample_rate();
 		aspec.format = AUDIO_S16SYS;    // keep endian independent
@@ -444,6 +574,11 @@ int sound_sdl::init(const osd_options &options)
 
 		sdl_xfer_samples = obtained.samples;
 
+		// adaptive buffering starts out two transfers ahead of the write position
+		adaptive = options.audio_adaptive();
+		stream_target = 2 * sdl_xfer_samples * sizeof(INT16) * 2;
+		stable_updates = 0;
+
 		// pin audio latency
 		audio_latency = MAX(MIN(m_audio_latency, MAX_AUDIO_LATENCY), 1);
 
@@ -494,12 +629,31 @@ void sound_sdl::exit()
 	sdl_destroy_buffers();
 
 	// print out over/underflow stats
-	if (buffer_overflows || buffer_underflows)
-		osd_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+	if (buffer_overflows || buffer_underflows || callback_underflows)
+		osd_printf_verbose("Sound buffer: overflows=%d underflows=%d callback underflows=%d\n", buffer_overflows, buffer_underflows, (int)callback_underflows);
+
+	// print out latency stats; what we hear lags the emulation by the data queued
+	// here, plus SDL's own transfer buffer, plus the core's mixing granularity
+	if (lead_count != 0)
+	{
+		double lead_avg = bytes_to_ms((double)lead_total / lead_count);
+		double device_ms = (double)sdl_xfer_samples * 1000.0 / sample_rate();
+		double update_ms = (double)frame_samples_total * 1000.0 / sample_rate() / lead_count;
+
+		osd_printf_verbose("Sound buffer: queued min/avg/max %.1f/%.1f/%.1f ms, device %.1f ms, update %.1f ms, estimated latency %.1f ms\n",
+				bytes_to_ms(lead_min), lead_avg, bytes_to_ms(lead_max), device_ms, update_ms, lead_avg + device_ms + update_ms);
+		if (adaptive)
+			osd_printf_verbose("Sound buffer: adaptive target %.1f ms beyond the write position\n", bytes_to_ms(stream_target));
+		for (int bucket = 0; bucket < LEAD_HISTOGRAM_BUCKETS; bucket++)
+			if (lead_histogram[bucket] != 0)
+				osd_printf_verbose("Sound buffer: %3d-%3d ms queued: %7d (%5.1f%%)\n",
+						bucket * LEAD_HISTOGRAM_MS, (bucket + 1) * LEAD_HISTOGRAM_MS, lead_histogram[bucket],
+						100.0 * lead_histogram[bucket] / lead_count);
+	}
 
 	if (LOG_SOUND)
 	{
-		fprintf(sound_log, "Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+		fprintf(sound_log, "Sound buffer: overflows=%d underflows=%d callback underflows=%d\n", buffer_overflows, buffer_underflows, (int)callback_underflows);
 		fclose(sound_log);
 	}
 }
@@ -27,6 +27,9 @@ public:
 	virtual void update_audio_stream(bool is_throttled, const INT16 *buffer, int samples_this_frame) = 0;
 	virtual void set_mastervolume(int attenuation) = 0;
 
+	// buffer fill from 0 (empty) to 1 (full), 0.5 being the target; negative if unknown
+	virtual float buffer_fill() { return -1.0f; }
+
 	int sample_rate() { return m_sample_rate; }
 
 	int m_sample_rate;
@@ -201,5 +201,6 @@ int osd_thread_adjust_priority(osd_thread *thread, int adjust)
 
 int osd_thread_cpu_affinity(osd_thread *thread, UINT32 mask)
 {
-	return TRUE;
+	HANDLE handle = (thread != nullptr) ? thread->handle : GetCurrentThread();
+	return (SetThreadAffinityMask(handle, mask) != 0) ? TRUE : FALSE;
 }
@@ -36,18 +36,15 @@
 typedef void *PVOID;
 #endif
 
-//============================================================
-//  DEBUGGING
-//============================================================
-
-#define KEEP_STATISTICS         (0)
-
 //============================================================
 //  PARAMETERS
 //============================================================
 
 #define ENV_PROCESSORS               "OSDPROCESSORS"
 #define ENV_WORKQUEUEMAXTHREADS      "OSDWORKQUEUEMAXTHREADS"
+#define ENV_WORKQUEUESTATS           "OSDWORKQUEUESTATS"
+#define ENV_WORKQUEUEAFFINITY        "OSDWORKQUEUEAFFINITY"
+#define ENV_WORKQUEUEMAXSPIN         "OSDWORKQUEUEMAXSPIN"
 
 #define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
 
@@ -55,15 +52,10 @@ typedef void *PVOID;
 //  MACROS
 //============================================================
 
-#if KEEP_STATISTICS
-#define add_to_stat(v,x)        do { atomic_add32((v), (x)); } while (0)
-#define begin_timing(v)         do { (v) -= get_profile_ticks(); } while (0)
-#define end_timing(v)           do { (v) += get_profile_ticks(); } while (0)
-#else
-#define add_to_stat(v,x)        do { } while (0)
-#define begin_timing(v)         do { } while (0)
-#define end_timing(v)           do { } while (0)
-#endif
+// statistics are only gathered when OSDWORKQUEUESTATS is set
+#define add_to_stat(q,v,x)      do { if ((q)->keepstats) atomic_add32((v), (x)); } while (0)
+#define begin_timing(q,v)       do { if ((q)->keepstats) (v) -= get_profile_ticks(); } while (0)
+#define end_timing(q,v)         do { if ((q)->keepstats) (v) += get_profile_ticks(); } while (0)
 
 template<typename _PtrType>
 static void spin_while(const volatile _PtrType * volatile ptr, const _PtrType val, const osd_ticks_t timeout, const int invert = 0)
@@ -98,13 +90,12 @@ struct work_thread_info
 	osd_event *         wakeevent;      // wake event for the thread
 	volatile INT32      active;         // are we actively processing work?
 
-#if KEEP_STATISTICS
-	INT32               itemsdone;
-	osd_ticks_t         actruntime;
-	osd_ticks_t         runtime;
-	osd_ticks_t         spintime;
-	osd_ticks_t         waittime;
-#endif
+	// statistics
+	volatile INT32      itemsdone;      // items processed by this thread
+	osd_ticks_t         actruntime;     // time spent in callbacks
+	osd_ticks_t         runtime;        // time spent processing the queue
+	osd_ticks_t         spintime;       // time spent spinning for more work
+	osd_ticks_t         waittime;       // time spent blocked or elsewhere
 };
 
 
@@ -122,13 +113,17 @@ struct osd_work_queue
 	UINT32              flags;          // creation flags
 	work_thread_info *  thread;         // array of thread information
 	osd_event   *       doneevent;      // event signalled when work is complete
+	osd_ticks_t         spinlimit;      // maximum time a worker spins looking for more work
+	osd_ticks_t         waitspinlimit;  // maximum time a waiter spins before blocking (0 = unlimited)
+	bool                keepstats;      // gather statistics?
 
-#if KEEP_STATISTICS
+	// statistics
 	volatile INT32      itemsqueued;    // total items queued
+	volatile INT32      maxitems;       // deepest the queue has been
 	volatile INT32      setevents;      // number of times we called SetEvent
 	volatile INT32      extraitems;     // how many extra items we got after the first in the queue loop
 	volatile INT32      spinloops;      // how many times spinning bought us more items
-#endif
+	volatile INT32      spintimeouts;   // how many times a waiter gave up spinning and blocked
 };
 
 
@@ -155,6 +150,7 @@ int osd_num_processors = 0;
 //============================================================
 
 static int effective_num_processors(void);
+static UINT32 effective_affinity_mask(void);
 static void * worker_thread_entry(void *param);
 static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
 static bool queue_has_list_items(osd_work_queue *queue);
@@ -172,6 +168,10 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	int osdthreadnum = 0;
 	int allocthreadnum;
 	const char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
+	const char *osdworkqueuestats = osd_getenv(ENV_WORKQUEUESTATS);
+	const char *osdworkqueuemaxspin = osd_getenv(ENV_WORKQUEUEMAXSPIN);
+	UINT32 affinity = effective_affinity_mask();
+	int maxspin;
 
 	// allocate a new queue
 	queue = (osd_work_queue *)osd_malloc(sizeof(*queue));
@@ -182,6 +182,18 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	// initialize basic queue members
 	queue->tailptr = (osd_work_item **)&queue->list;
 	queue->flags = flags;
+	queue->keepstats = (osdworkqueuestats != NULL && atoi(osdworkqueuestats) != 0);
+
+	// determine how long we are allowed to spin; the limit is in microseconds, and
+	// also bounds how long osd_work_queue_wait spins on high frequency queues
+	queue->spinlimit = SPIN_LOOP_TIME;
+	if (osdworkqueuemaxspin != NULL && sscanf(osdworkqueuemaxspin, "%d", &maxspin) == 1 && maxspin >= 0)
+	{
+		queue->waitspinlimit = (osd_ticks_t)maxspin * osd_ticks_per_second() / 1000000;
+		queue->spinlimit = MIN(queue->spinlimit, queue->waitspinlimit);
+		if (queue->waitspinlimit == 0)
+			queue->waitspinlimit = 1;
+	}
 
 	// allocate events for the queue
 	queue->doneevent = osd_event_alloc(TRUE, TRUE);     // manual reset, signalled
@@ -213,9 +225,8 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	else
 		allocthreadnum = queue->threads;
 
-#if KEEP_STATISTICS
-	printf("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads);
-#endif
+	if (queue->keepstats)
+		osd_printf_info("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d affinity: %08X\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads, affinity);
 
 	queue->thread = (work_thread_info *)osd_malloc_array(allocthreadnum * sizeof(queue->thread[0]));
 	if (queue->thread == NULL)
@@ -246,12 +257,16 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 			osd_thread_adjust_priority(thread->handle, 1);
 		else
 			osd_thread_adjust_priority(thread->handle, 0);
+
+		// restrict it to the requested set of CPUs
+		if (affinity != 0)
+			osd_thread_cpu_affinity(thread->handle, affinity);
 	}
 
 	// start a timer going for "waittime" on the main thread
 	if (flags & WORK_QUEUE_FLAG_MULTI)
 	{
-		begin_timing(queue->thread[queue->threads].waittime);
+		begin_timing(queue, queue->thread[queue->threads].waittime);
 	}
 	return queue;
 
@@ -291,7 +306,7 @@ int osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 	{
 		work_thread_info *thread = &queue->thread[queue->threads];
 
-		end_timing(thread->waittime);
+		end_timing(queue, thread->waittime);
 
 		// process what we can as a worker thread
 		worker_thread_process(queue, thread);
@@ -299,15 +314,20 @@ int osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 		// if we're a high frequency queue, spin until done
 		if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->items != 0)
 		{
-			// spin until we're done
-			begin_timing(thread->spintime);
-			spin_while_not(&queue->items, 0, timeout);
-			end_timing(thread->spintime);
+			// spin until we're done, or until we've hit the spin limit
+			begin_timing(queue, thread->spintime);
+			spin_while_not(&queue->items, 0, (queue->waitspinlimit != 0) ? MIN(timeout, queue->waitspinlimit) : timeout);
+			end_timing(queue, thread->spintime);
+
+			begin_timing(queue, thread->waittime);
+			if (queue->waitspinlimit == 0 || queue->items == 0)
+				return (queue->items == 0);
 
-			begin_timing(thread->waittime);
-			return (queue->items == 0);
+			// out of patience; fall through and block like everyone else
+			add_to_stat(queue, &queue->spintimeouts, 1);
 		}
-		begin_timing(thread->waittime);
+		else
+			begin_timing(queue, thread->waittime);
 	}
 
 	// reset our done event and double-check the items before waiting
@@ -336,7 +356,7 @@ void osd_work_queue_free(osd_work_queue *queue)
 		// stop the timer for "waittime" on the main thread
 		if (queue->flags & WORK_QUEUE_FLAG_MULTI)
 		{
-			end_timing(queue->thread[queue->threads].waittime);
+			end_timing(queue, queue->thread[queue->threads].waittime);
 		}
 
 		// signal all the threads to exit
@@ -364,27 +384,36 @@ void osd_work_queue_free(osd_work_queue *queue)
 				osd_event_free(thread->wakeevent);
 		}
 
-#if KEEP_STATISTICS
-		int allocthreadnum;
-		if (queue->flags & WORK_QUEUE_FLAG_MULTI)
-			allocthreadnum = queue->threads + 1;
-		else
-			allocthreadnum = queue->threads;
-
-		// output per-thread statistics
-		for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
+		if (queue->keepstats)
 		{
-			work_thread_info *thread = &queue->thread[threadnum];
-			osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
-			printf("Thread %d:  items=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
-					threadnum, thread->itemsdone,
-					(double)thread->runtime * 100.0 / (double)total,
-					(double)thread->actruntime * 100.0 / (double)total,
-					(double)thread->spintime * 100.0 / (double)total,
-					(double)thread->waittime * 100.0 / (double)total,
-					(UINT32) total);
+			int allocthreadnum;
+			if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+				allocthreadnum = queue->threads + 1;
+			else
+				allocthreadnum = queue->threads;
+
+			// output per-thread statistics; the extra thread on multi queues is the
+			// caller, whose items were taken over while waiting for the queue to drain
+			osd_printf_info("Work queue %p (%s%s%s), %d threads:\n", (void *)queue,
+					(queue->flags & WORK_QUEUE_FLAG_MULTI) ? "multi" : "single",
+					(queue->flags & WORK_QUEUE_FLAG_IO) ? ", I/O" : "",
+					(queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ) ? ", high freq" : "",
+					queue->threads);
+			for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
+			{
+				work_thread_info *thread = &queue->thread[threadnum];
+				osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
+				if (total == 0)
+					total = 1;
+				osd_printf_info("%s %2d:  items=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%%\n",
+						(threadnum == queue->threads) ? "Caller" : "Thread",
+						threadnum, thread->itemsdone,
+						(double)thread->runtime * 100.0 / (double)total,
+						(double)thread->actruntime * 100.0 / (double)total,
+						(double)thread->spintime * 100.0 / (double)total,
+						(double)thread->waittime * 100.0 / (double)total);
+			}
 		}
-#endif
 	}
 
 	// free the list
@@ -415,12 +444,15 @@ void osd_work_queue_free(osd_work_queue *queue)
 		osd_free(item);
 	}
 
-#if KEEP_STATISTICS
-	printf("Items queued   = %9d\n", queue->itemsqueued);
-	printf("SetEvent calls = %9d\n", queue->setevents);
-	printf("Extra items    = %9d\n", queue->extraitems);
-	printf("Spin loops     = %9d\n", queue->spinloops);
-#endif
+	if (queue->keepstats)
+	{
+		osd_printf_info("Items queued   = %9d\n", queue->itemsqueued);
+		osd_printf_info("Max depth      = %9d\n", queue->maxitems);
+		osd_printf_info("SetEvent calls = %9d\n", queue->setevents);
+		osd_printf_info("Extra items    = %9d\n", queue->extraitems);
+		osd_printf_info("Spin loops     = %9d\n", queue->spinloops);
+		osd_printf_info("Spin timeouts  = %9d\n", queue->spintimeouts);
+	}
 
 	delete queue->lock;
 	// free the queue itself
@@ -492,8 +524,10 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 	}
 
 	// increment the number of items in the queue
-	atomic_add32(&queue->items, numitems);
-	add_to_stat(&queue->itemsqueued, numitems);
+	INT32 depth = atomic_add32(&queue->items, numitems);
+	add_to_stat(queue, &queue->itemsqueued, numitems);
+	if (queue->keepstats && depth > queue->maxitems)
+		queue->maxitems = depth;
 
 	// look for free threads to do the work
 	if (queue->livethreads < queue->threads)
@@ -509,7 +543,7 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 			if (!thread->active)
 			{
 				osd_event_set(thread->wakeevent);
-				add_to_stat(&queue->setevents, 1);
+				add_to_stat(queue, &queue->setevents, 1);
 
 				// for non-shared, the first one we find is good enough
 				if (--numitems == 0)
@@ -521,9 +555,9 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 	// if no threads, run the queue now on this thread
 	if (queue->threads == 0)
 	{
-		end_timing(queue->thread[0].waittime);
+		end_timing(queue, queue->thread[0].waittime);
 		worker_thread_process(queue, &queue->thread[0]);
-		begin_timing(queue->thread[0].waittime);
+		begin_timing(queue, queue->thread[0].waittime);
 	}
 	// only return the item if it won't get released automatically
 	return (flags & WORK_ITEM_FLAG_AUTO_RELEASE) ? NULL : lastitem;
@@ -627,6 +661,46 @@ static int effective_num_processors(void)
 }
 
 
+//============================================================
+//  effective_affinity_mask
+//============================================================
+
+static UINT32 effective_affinity_mask(void)
+{
+	// OSDWORKQUEUEAFFINITY is a list of CPUs and CPU ranges, e.g. "0-3,8,10"
+	const char *affinity = osd_getenv(ENV_WORKQUEUEAFFINITY);
+	UINT32 mask = 0;
+
+	if (affinity == NULL)
+		return 0;
+
+	while (*affinity != 0)
+	{
+		int first, last, chars;
+
+		if (sscanf(affinity, "%d-%d%n", &first, &last, &chars) == 2)
+			affinity += chars;
+		else if (sscanf(affinity, "%d%n", &first, &chars) == 1)
+		{
+			last = first;
+			affinity += chars;
+		}
+		else
+			return 0;
+
+		// only the first 32 CPUs can be represented in the mask
+		for (int cpu = MAX(first, 0); cpu <= last && cpu < 32; cpu++)
+			mask |= 1U << cpu;
+
+		if (*affinity == ',')
+			affinity++;
+		else if (*affinity != 0)
+			return 0;
+	}
+	return mask;
+}
+
+
 //============================================================
 //  worker_thread_entry
 //============================================================
@@ -650,9 +724,9 @@ static void *worker_thread_entry(void *param)
 
 		if (!queue_has_list_items(queue))
 		{
-			begin_timing(thread->waittime);
+			begin_timing(queue, thread->waittime);
 			osd_event_wait(thread->wakeevent, OSD_EVENT_WAIT_INFINITE);
-			end_timing(thread->waittime);
+			end_timing(queue, thread->waittime);
 		}
 
 		if (queue->exiting)
@@ -669,18 +743,18 @@ static void *worker_thread_entry(void *param)
 			worker_thread_process(queue, thread);
 
 			// if we're a high frequency queue, spin for a while before giving up
-			if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->list == NULL)
+			if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->list == NULL && queue->spinlimit != 0)
 			{
 				// spin for a while looking for more work
-				begin_timing(thread->spintime);
-				spin_while(&queue->list, (osd_work_item *)NULL, SPIN_LOOP_TIME);
-				end_timing(thread->spintime);
+				begin_timing(queue, thread->spintime);
+				spin_while(&queue->list, (osd_work_item *)NULL, queue->spinlimit);
+				end_timing(queue, thread->spintime);
 			}
 
 			// if nothing more, release the processor
 			if (!queue_has_list_items(queue))
 				break;
-			add_to_stat(&queue->spinloops, 1);
+			add_to_stat(queue, &queue->spinloops, 1);
 		}
 
 		// decrement the live thread count
@@ -704,7 +778,7 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 {
 	int threadid = thread - queue->thread;
 
-	begin_timing(thread->runtime);
+	begin_timing(queue, thread->runtime);
 
 	// loop until everything is processed
 	while (true)
@@ -741,14 +815,14 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 		if (item != NULL)
 		{
 			// call the callback and stash the result
-			begin_timing(thread->actruntime);
+			begin_timing(queue, thread->actruntime);
 			item->result = (*item->callback)(item->param, threadid);
-			end_timing(thread->actruntime);
+			end_timing(queue, thread->actruntime);
 
 			// decrement the item count after we are done
 			atomic_decrement32(&queue->items);
 			atomic_exchange32(&item->done, TRUE);
-			add_to_stat(&thread->itemsdone, 1);
+			add_to_stat(queue, &thread->itemsdone, 1);
 
 			// if it's an auto-release item, release it
 			if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
@@ -761,14 +835,14 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 				if (item->event != NULL)
 				{
 					osd_event_set(item->event);
-					add_to_stat(&item->queue->setevents, 1);
+					add_to_stat(queue, &item->queue->setevents, 1);
 				}
 				queue->lock->unlock();
 			}
 
 			// if we removed an item and there's still work to do, bump the stats
 			if (queue_has_list_items(queue))
-				add_to_stat(&queue->extraitems, 1);
+				add_to_stat(queue, &queue->extraitems, 1);
 		}
 	}
 
@@ -776,10 +850,10 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 	if (queue->waiting)
 	{
 		osd_event_set(queue->doneevent);
-		add_to_stat(&queue->setevents, 1);
+		add_to_stat(queue, &queue->setevents, 1);
 	}
 
-	end_timing(thread->runtime);
+	end_timing(queue, thread->runtime);
 }
 
 bool queue_has_list_items(osd_work_queue *queue)
@@ -202,6 +202,47 @@ file_error osd_openpty(osd_file **file, char *name, size_t name_len);
 file_error osd_truncate(osd_file *file, UINT64 offset);
 
 
+/*-----------------------------------------------------------------------------
+    osd_map: map the start of an open file read-only into memory
+
+    Parameters:
+
+        file - handle to a file previously opened via osd_open
+
+        length - number of bytes to map, starting at offset 0; this must
+            not be larger than the file
+
+        base - pointer to a const void * to receive the address of the
+            mapped data; this is only valid if the function returns
+            FILERR_NONE
+
+    Return value:
+
+        a file_error describing any error that occurred while mapping the
+        file, or FILERR_NONE if no error occurred; callers must be prepared
+        to fall back to osd_read, as not every file or OSD can be mapped
+
+    Notes:
+
+        The mapping stays valid until osd_unmap is called, even if the
+        file is closed first.  Writes made through osd_write are visible
+        through the mapping, but growing the file does not extend it.
+-----------------------------------------------------------------------------*/
+file_error osd_map(osd_file *file, UINT64 length, const void **base);
+
+
+/*-----------------------------------------------------------------------------
+    osd_unmap: release a mapping created by osd_map
+
+    Parameters:
+
+        base - address returned by osd_map
+
+        length - length that was passed to osd_map
+-----------------------------------------------------------------------------*/
+void osd_unmap(const void *base, UINT64 length);
+
+
 /*-----------------------------------------------------------------------------
     osd_rmfile: deletes a file
 
@@ -60,6 +60,7 @@ public:
 	virtual void update_audio_stream(const INT16 *buffer, int samples_this_frame) = 0;
 	virtual void set_mastervolume(int attenuation) = 0;
 	virtual bool no_sound() = 0;
+	virtual float audio_buffer_fill() = 0;
 
 	// input overridables
 	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist) = 0;
@@ -129,6 +129,25 @@ file_error osd_truncate(osd_file *file, UINT64 offset)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	return FILERR_FAILURE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(const void *base, UINT64 length)
+{
+}
+
+
 //============================================================
 //  osd_rmfile
 //============================================================
@@ -33,6 +33,7 @@
 #endif
 
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
@@ -370,6 +371,34 @@ file_error osd_truncate(osd_file *file, UINT64 offset)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	if (!file || file->type != SDLFILE_FILE || length == 0 || length != (size_t)length)
+		return FILERR_FAILURE;
+
+	void *result = mmap(NULL, length, PROT_READ, MAP_SHARED, file->handle, 0);
+	if (result == MAP_FAILED)
+		return error_to_file_error(errno);
+
+	*base = result;
+	return FILERR_NONE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(const void *base, UINT64 length)
+{
+	munmap(const_cast<void *>(base), length);
+}
+
+
 //============================================================
 //  osd_close
 //============================================================
@@ -282,6 +282,40 @@ file_error osd_truncate(osd_file *file, UINT64 offset)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	if (!file || !file->handle || file->type != WINFILE_FILE || length == 0 || length != (SIZE_T)length)
+		return FILERR_FAILURE;
+
+	// the view keeps the mapping object alive, so we don't need to hold on to it
+	HANDLE mapping = CreateFileMapping(file->handle, NULL, PAGE_READONLY, (DWORD)(length >> 32), (DWORD)length, NULL);
+	if (mapping == NULL)
+		return win_error_to_mame_file_error(GetLastError());
+	void *result = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)length);
+	DWORD error = GetLastError();
+	CloseHandle(mapping);
+	if (result == NULL)
+		return win_error_to_mame_file_error(error);
+
+	*base = result;
+	return FILERR_NONE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(const void *base, UINT64 length)
+{
+	UnmapViewOfFile(base);
+}
+
+
 //============================================================
 //  osd_close
 //============================================================
@@ -38,6 +38,9 @@ const UINT32 IDE_SECTOR_SIZE = 512;
 // temporary input buffer size
 const UINT32 TEMP_BUFFER_SIZE = 32 * 1024 * 1024;
 
+// hunks to decompress ahead on worker threads when extracting or verifying
+const UINT32 READAHEAD_HUNKS = 2 * WORK_MAX_THREADS;
+
 // modes
 const int MODE_NORMAL = 0;
 const int MODE_CUEBIN = 1;
@@ -532,7 +535,7 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression, extraction or verification" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -553,7 +556,8 @@ static const command_description s_commands[] =
 	{ COMMAND_VERIFY, do_verify, ": verifies a CHD's integrity",
 		{
 			REQUIRED OPTION_INPUT,
-			OPTION_INPUT_PARENT
+			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -629,7 +633,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -642,7 +647,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -653,6 +659,7 @@ static const command_description s_commands[] =
 			OPTION_OUTPUT_FORCE,
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -1124,6 +1131,48 @@ static void parse_numprocessors(const parameters_t &params)
 }
 
 
+//-------------------------------------------------
+//  enable_readahead - have the input CHD
+//  decompress upcoming hunks on worker threads
+//  while we write out or checksum the current ones
+//-------------------------------------------------
+
+static void enable_readahead(const parameters_t &params, chd_file &input_chd)
+{
+	// the worker queue honours the processor limit
+	parse_numprocessors(params);
+
+	// keep the window within the size of our own buffers
+	UINT32 readahead = MAX(MIN(READAHEAD_HUNKS, TEMP_BUFFER_SIZE / input_chd.hunk_bytes()), 1);
+	input_chd.set_cache_size(readahead + 2, readahead);
+}
+
+
+//-------------------------------------------------
+//  report_cache_stats - print how the input CHD's
+//  hunk cache and read ahead performed
+//-------------------------------------------------
+
+static void report_cache_stats(const chd_file &input_chd)
+{
+	printf("Hunk cache: %" I64FMT "d hits (%" I64FMT "d from read ahead), %" I64FMT "d misses\n", input_chd.cache_hits(), input_chd.readahead_hits(), input_chd.cache_misses());
+}
+
+
+//-------------------------------------------------
+//  megabytes_per_second - compute the throughput
+//  since the given start time
+//-------------------------------------------------
+
+static double megabytes_per_second(UINT64 bytes, osd_ticks_t start)
+{
+	osd_ticks_t elapsed = osd_ticks() - start;
+	if (elapsed == 0)
+		return 0;
+	return double(bytes) / (1024.0 * 1024.0) * double(osd_ticks_per_second()) / double(elapsed);
+}
+
+
 //-------------------------------------------------
 //  compression_string - create a friendly string
 //  describing a set of compressors
@@ -1502,14 +1551,18 @@ static void do_verify(parameters_t &params)
 	if (raw_sha1 == sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
+	// decompress ahead on the worker threads
+	enable_readahead(params, input_chd);
+
 	// create an array to read into
 	dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
 
 	// read all the data and build up an SHA-1
 	sha1_creator rawsha1;
+	osd_ticks_t start_time = osd_ticks();
 	for (UINT64 offset = 0; offset < input_chd.logical_bytes(); )
 	{
-		progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(offset) / double(input_chd.logical_bytes()));
+		progress(false, "Verifying, %.1f%% complete... (%.1f MB/s)  \r", 100.0 * double(offset) / double(input_chd.logical_bytes()), megabytes_per_second(offset, start_time));
 
 		// determine how much to read
 		UINT32 bytes_to_read = MIN((UINT32)buffer.size(), input_chd.logical_bytes() - offset);
@@ -1522,6 +1575,8 @@ static void do_verify(parameters_t &params)
 		offset += bytes_to_read;
 	}
 	sha1_t computed_sha1 = rawsha1.finish();
+	progress(true, "Verification complete ... %.1f MB/s                  \n", megabytes_per_second(input_chd.logical_bytes(), start_time));
+	report_cache_stats(input_chd);
 
 	// finish up
 	if (raw_sha1 != computed_sha1)
@@ -2247,11 +2302,15 @@ static void do_extract_raw(parameters_t &params)
 		if (filerr != FILERR_NONE)
 			report_error(1, "Unable to open file (%s)", output_file_str->second->c_str());
 
+		// decompress ahead on the worker threads; the output is still written in order here
+		enable_readahead(params, input_chd);
+
 		// copy all data
 		dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+		osd_ticks_t start_time = osd_ticks();
 		for (UINT64 offset = input_start; offset < input_end; )
 		{
-			progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(offset - input_start) / double(input_end - input_start));
+			progress(false, "Extracting, %.1f%% complete... (%.1f MB/s)  \r", 100.0 * double(offset - input_start) / double(input_end - input_start), megabytes_per_second(offset - input_start, start_time));
 
 			// determine how much to read
 			UINT32 bytes_to_read = MIN((UINT32)buffer.size(), input_end - offset);
@@ -2270,7 +2329,8 @@ static void do_extract_raw(parameters_t &params)
 
 		// finish up
 		core_fclose(output_file);
-		printf("Extraction complete                                    \n");
+		printf("Extraction complete ... %.1f MB/s                      \n", megabytes_per_second(input_end - input_start, start_time));
+		report_cache_stats(input_chd);
 	}
 	catch (...)
 	{
@@ -2371,10 +2431,15 @@ static void do_extract_cd(parameters_t &params)
 			core_fprintf(output_toc_file, "%d\n", toc->numtrks);
 		}
 
+		// decompress ahead on the worker threads; the output is still written in order here
+		enable_readahead(params, input_chd);
+
 		// iterate over tracks and copy all data
 		UINT64 outputoffs = 0;
+		UINT64 totaloffs = 0;
 		UINT32 discoffs = 0;
 		dynamic_buffer buffer;
+		osd_ticks_t start_time = osd_ticks();
 		for (int tracknum = 0; tracknum < toc->numtrks; tracknum++)
 		{
 			std::string trackbin_name(basename);
@@ -2431,7 +2496,7 @@ static void do_extract_cd(parameters_t &params)
 			UINT32 actualframes = trackinfo.frames - trackinfo.padframes;
 			for (UINT32 frame = 0; frame < actualframes; frame++)
 			{
-				progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(outputoffs) / double(total_bytes));
+				progress(false, "Extracting, %.1f%% complete... (%.1f MB/s)  \r", 100.0 * double(totaloffs) / double(total_bytes), megabytes_per_second(totaloffs, start_time));
 
 				// read the data
 				cdrom_read_data(cdrom, cdrom_get_track_start_phys(cdrom, tracknum) + frame, &buffer[bufferoffs], trackinfo.trktype, true);
@@ -2463,6 +2528,7 @@ static void do_extract_cd(parameters_t &params)
 					if (byteswritten != bufferoffs)
 						report_error(1, "Error writing frame %d to file (%s): %s\n", frame, output_file_str->second->c_str(), chd_file::error_string(CHDERR_WRITE_ERROR));
 					outputoffs += bufferoffs;
+					totaloffs += bufferoffs;
 					bufferoffs = 0;
 				}
 			}
@@ -2473,7 +2539,8 @@ static void do_extract_cd(parameters_t &params)
 		// finish up
 		core_fclose(output_bin_file);
 		core_fclose(output_toc_file);
-		printf("Extraction complete                                    \n");
+		printf("Extraction complete ... %.1f MB/s                      \n", megabytes_per_second(totaloffs, start_time));
+		report_cache_stats(input_chd);
 	}
 	catch (...)
 	{
@@ -2624,7 +2691,7 @@ static void do_extract_ld(parameters_t &params)
 			}
 		}
 
-		// close and return
+		// close and return; hunks were decoded through avhuff, not the hunk cache
 		avi_close(output_file);
 		printf("Extraction complete                                    \n");
 	}
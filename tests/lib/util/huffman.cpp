@@ -0,0 +1,157 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+#include "gtest/gtest.h"
+#include "huffman.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// exposes the code lengths the tree was built with
+class test_encoder : public huffman_encoder<>
+{
+public:
+   int code_bits(int code) const { return m_huffnode[code].m_numbits; }
+};
+
+// a geometric distribution gives codes up to the 16 bit limit, well past
+// the 11 bits handled by the lookup table
+void build_skewed_data(std::vector<UINT8> &data)
+{
+   data.clear();
+   for (int code = 0; code < 48; code++)
+      data.insert(data.end(), (code < 14) ? (1 << (14 - code)) : 1, code * 5);
+
+   UINT32 rnd = 1;
+   for (size_t i = data.size() - 1; i > 0; i--)
+   {
+      rnd = rnd * 1664525 + 1013904223;
+      std::swap(data[i], data[(rnd >> 8) % (i + 1)]);
+   }
+}
+
+// build a tree for the data and encode it, returning the tree and the codes
+int encode_data(const std::vector<UINT8> &data, std::vector<UINT8> &tree, std::vector<UINT8> &codes)
+{
+   test_encoder encoder;
+   for (UINT8 value : data)
+      encoder.histo_one(value);
+   EXPECT_EQ(HUFFERR_NONE, encoder.compute_tree_from_histo());
+
+   tree.resize(1024);
+   bitstream_out treebits(&tree[0], tree.size());
+   EXPECT_EQ(HUFFERR_NONE, encoder.export_tree_rle(treebits));
+   tree.resize(treebits.flush());
+
+   codes.resize(data.size() * 3);
+   bitstream_out codebits(&codes[0], codes.size());
+   for (UINT8 value : data)
+      encoder.encode_one(codebits, value);
+   codes.resize(codebits.flush());
+
+   int maxbits = 0;
+   for (int code = 0; code < 256; code++)
+      maxbits = std::max(maxbits, encoder.code_bits(code));
+   return maxbits;
+}
+
+} // anonymous namespace
+
+TEST(huffman,decode_one_long_codes)
+{
+   std::vector<UINT8> data, tree, codes;
+   build_skewed_data(data);
+   EXPECT_GT(encode_data(data, tree, codes), 11);
+
+   huffman_decoder<> decoder;
+   bitstream_in treebits(&tree[0], tree.size());
+   EXPECT_EQ(HUFFERR_NONE, decoder.import_tree_rle(treebits));
+
+   bitstream_in codebits(&codes[0], codes.size());
+   std::vector<UINT8> dest(data.size());
+   for (size_t i = 0; i < dest.size(); i++)
+      dest[i] = decoder.decode_one(codebits);
+   EXPECT_FALSE(codebits.overflow());
+   EXPECT_TRUE(dest == data);
+}
+
+TEST(huffman,decode_multiple_long_codes)
+{
+   std::vector<UINT8> data, tree, codes;
+   build_skewed_data(data);
+   EXPECT_GT(encode_data(data, tree, codes), 11);
+
+   huffman_decoder<> decoder;
+   bitstream_in treebits(&tree[0], tree.size());
+   EXPECT_EQ(HUFFERR_NONE, decoder.import_tree_rle(treebits));
+
+   // an odd count takes the single code path at the end too
+   bitstream_in codebits(&codes[0], codes.size());
+   std::vector<UINT8> dest(data.size());
+   decoder.decode_multiple(codebits, &dest[0], dest.size() - 1);
+   dest.back() = decoder.decode_one(codebits);
+   EXPECT_FALSE(codebits.overflow());
+   EXPECT_TRUE(dest == data);
+}
+
+TEST(huffman,decode_pairs_long_codes)
+{
+   std::vector<UINT8> data;
+   build_skewed_data(data);
+   data.resize(data.size() & ~1);
+
+   // even bytes use the skewed tree, odd bytes a second, flatter one
+   std::vector<UINT8> second(data.size() / 2);
+   for (size_t i = 0; i < second.size(); i++)
+      second[i] = i * 7;
+   test_encoder encoder[2];
+   for (size_t i = 0; i < second.size(); i++)
+   {
+      encoder[0].histo_one(data[i * 2]);
+      encoder[1].histo_one(second[i]);
+   }
+   huffman_decoder<> decoder[2];
+   for (int which = 0; which < 2; which++)
+   {
+      EXPECT_EQ(HUFFERR_NONE, encoder[which].compute_tree_from_histo());
+      std::vector<UINT8> tree(1024);
+      bitstream_out treebits(&tree[0], tree.size());
+      encoder[which].export_tree_rle(treebits);
+      tree.resize(treebits.flush());
+      bitstream_in treein(&tree[0], tree.size());
+      EXPECT_EQ(HUFFERR_NONE, decoder[which].import_tree_rle(treein));
+   }
+
+   std::vector<UINT8> codes(data.size() * 3);
+   bitstream_out codebits(&codes[0], codes.size());
+   for (size_t i = 0; i < second.size(); i++)
+   {
+      encoder[0].encode_one(codebits, data[i * 2]);
+      encoder[1].encode_one(codebits, second[i]);
+   }
+   codes.resize(codebits.flush());
+
+   bitstream_in codein(&codes[0], codes.size());
+   std::vector<UINT16> dest(second.size());
+   decoder[0].decode_pairs(codein, decoder[1], &dest[0], dest.size());
+   EXPECT_FALSE(codein.overflow());
+   for (size_t i = 0; i < dest.size(); i++)
+      EXPECT_EQ((data[i * 2] << 8) | second[i], dest[i]);
+}
+
+TEST(huffman,huffman_8bit_round_trip)
+{
+   std::vector<UINT8> data;
+   build_skewed_data(data);
+
+   huffman_8bit_encoder encoder;
+   std::vector<UINT8> comp(data.size() * 3);
+   UINT32 complen;
+   EXPECT_EQ(HUFFERR_NONE, encoder.encode(&data[0], data.size(), &comp[0], comp.size(), complen));
+
+   huffman_8bit_decoder decoder;
+   std::vector<UINT8> dest(data.size());
+   EXPECT_EQ(HUFFERR_NONE, decoder.decode(&comp[0], complen, &dest[0], dest.size()));
+   EXPECT_TRUE(dest == data);
+}
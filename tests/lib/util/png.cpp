@@ -0,0 +1,245 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+
+#include "gtest/gtest.h"
+#include "png.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const char *const TEMP_PNG = "png_test.png";
+
+// deterministic pseudo random source
+UINT32 next_random(UINT32 &state)
+{
+   state = state * 1664525 + 1013904223;
+   return state >> 8;
+}
+
+void append_32bit(std::vector<UINT8> &data, UINT32 value)
+{
+   data.push_back(value >> 24);
+   data.push_back(value >> 16);
+   data.push_back(value >> 8);
+   data.push_back(value);
+}
+
+void append_chunk(std::vector<UINT8> &file, UINT32 type, const std::vector<UINT8> &data)
+{
+   append_32bit(file, data.size());
+   const size_t start = file.size();
+   append_32bit(file, type);
+   file.insert(file.end(), data.begin(), data.end());
+   append_32bit(file, crc32(0, &file[start], file.size() - start));
+}
+
+UINT8 paeth_reference(int a, int b, int c)
+{
+   const int p = a + b - c;
+   const int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+   if (pa <= pb && pa <= pc)
+      return a;
+   return (pb <= pc) ? b : c;
+}
+
+// the filters as written out in the PNG specification, a byte at a time
+void filter_reference(int type, const UINT8 *raw, const UINT8 *prev, int bpp, int rowbytes, UINT8 *dest)
+{
+   for (int x = 0; x < rowbytes; x++)
+   {
+      const int a = (x >= bpp) ? raw[x - bpp] : 0;
+      const int b = prev[x];
+      const int c = (x >= bpp) ? prev[x - bpp] : 0;
+      switch (type)
+      {
+         case PNG_PF_None:    dest[x] = raw[x]; break;
+         case PNG_PF_Sub:     dest[x] = raw[x] - a; break;
+         case PNG_PF_Up:      dest[x] = raw[x] - b; break;
+         case PNG_PF_Average: dest[x] = raw[x] - (a + b) / 2; break;
+         case PNG_PF_Paeth:   dest[x] = raw[x] - paeth_reference(a, b, c); break;
+      }
+   }
+}
+
+// build a PNG of noise with every row filtered by the reference filters,
+// cycling through the given filter types; returns the unfiltered image
+std::vector<UINT8> build_filtered_png(std::vector<UINT8> &file, int width, int height, int bit_depth, int color_type, const std::vector<int> &filters)
+{
+   static const int samples[] = { 1, 0, 3, 1, 2, 0, 4 };
+   const int bits = samples[color_type] * bit_depth;
+   const int bpp = (bits < 8) ? 1 : bits / 8;
+   const int rowbytes = (width * bits + 7) / 8;
+
+   std::vector<UINT8> raw(rowbytes * height);
+   UINT32 rnd = width * 31 + bit_depth * 7 + color_type;
+   for (auto &value : raw)
+      value = next_random(rnd);
+
+   std::vector<UINT8> filtered;
+   const std::vector<UINT8> zeroes(rowbytes, 0);
+   for (int y = 0; y < height; y++)
+   {
+      const int type = filters[y % filters.size()];
+      filtered.push_back(type);
+      filtered.resize(filtered.size() + rowbytes);
+      filter_reference(type, &raw[y * rowbytes], (y == 0) ? &zeroes[0] : &raw[(y - 1) * rowbytes], bpp, rowbytes, &filtered[filtered.size() - rowbytes]);
+   }
+
+   std::vector<UINT8> header;
+   append_32bit(header, width);
+   append_32bit(header, height);
+   header.push_back(bit_depth);
+   header.push_back(color_type);
+   header.push_back(0);
+   header.push_back(0);
+   header.push_back(0);
+
+   uLongf complen = compressBound(filtered.size());
+   std::vector<UINT8> comp(complen);
+   EXPECT_EQ(Z_OK, compress2(&comp[0], &complen, &filtered[0], filtered.size(), 9));
+   comp.resize(complen);
+
+   file.assign(PNG_Signature, PNG_Signature + 8);
+   append_chunk(file, PNG_CN_IHDR, header);
+   append_chunk(file, PNG_CN_IDAT, comp);
+   append_chunk(file, PNG_CN_IEND, std::vector<UINT8>());
+   return raw;
+}
+
+// read a PNG built above and check it unfilters back to the noise
+void check_unfilter(int width, int height, int bit_depth, int color_type, const std::vector<int> &filters)
+{
+   std::vector<UINT8> file;
+   const std::vector<UINT8> raw = build_filtered_png(file, width, height, bit_depth, color_type, filters);
+
+   core_file *fp;
+   ASSERT_EQ(FILERR_NONE, core_fopen_ram(&file[0], file.size(), OPEN_FLAG_READ, &fp));
+   png_info info;
+   EXPECT_EQ(PNGERR_NONE, png_read_file(fp, &info));
+   core_fclose(fp);
+
+   EXPECT_TRUE(std::equal(raw.begin(), raw.end(), info.image)) << "width " << width << " depth " << bit_depth << " color type " << color_type;
+   png_free(&info);
+}
+
+// unfilter every filter at every byte per pixel count that has its own path
+void check_filter(int type)
+{
+   static const int widths[] = { 1, 5, 37 };
+   const std::vector<int> filters(1, type);
+   for (int width : widths)
+   {
+      check_unfilter(width, 7, 8, 0, filters);
+      check_unfilter(width, 7, 8, 2, filters);
+      check_unfilter(width, 7, 8, 6, filters);
+      check_unfilter(width, 7, 16, 2, filters);
+   }
+}
+
+// a noisy image with some smooth areas, so the writer picks different filters per row
+template <typename _BitmapType>
+void build_noisy_bitmap(_BitmapType &bitmap, int width, int height, bool alpha)
+{
+   UINT32 rnd = width;
+   bitmap.allocate(width, height);
+   for (int y = 0; y < height; y++)
+      for (int x = 0; x < width; x++)
+      {
+         UINT32 pixel = ((x * 4) << 16) | ((y * 8) << 8) | ((x + y) * 2);
+         if ((y & 3) != 0)
+            pixel ^= next_random(rnd) & ((y & 2) ? 0xffffff : 0x070707);
+         const UINT32 a = alpha ? next_random(rnd) & 0xff : 0xff;
+         bitmap.pix32(y, x) = (a << 24) | (pixel & 0xffffff);
+      }
+}
+
+// write a bitmap to disk and read it back
+void write_and_read(bitmap_t &bitmap, bitmap_argb32 &result)
+{
+   core_file *fp;
+   ASSERT_EQ(FILERR_NONE, core_fopen(TEMP_PNG, OPEN_FLAG_READ | OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, &fp));
+   EXPECT_EQ(PNGERR_NONE, png_write_bitmap(fp, nullptr, bitmap, 0, nullptr));
+   core_fseek(fp, 0, SEEK_SET);
+   EXPECT_EQ(PNGERR_NONE, png_read_bitmap(fp, result));
+   core_fclose(fp);
+   osd_rmfile(TEMP_PNG);
+}
+
+} // anonymous namespace
+
+TEST(png,unfilter_none)
+{
+   check_filter(PNG_PF_None);
+}
+
+TEST(png,unfilter_sub)
+{
+   check_filter(PNG_PF_Sub);
+}
+
+TEST(png,unfilter_up)
+{
+   check_filter(PNG_PF_Up);
+}
+
+TEST(png,unfilter_average)
+{
+   check_filter(PNG_PF_Average);
+}
+
+TEST(png,unfilter_paeth)
+{
+   check_filter(PNG_PF_Paeth);
+}
+
+TEST(png,unfilter_sub_byte_depth)
+{
+   // below 8 bits the filters step a byte at a time, not a pixel
+   std::vector<int> filters;
+   filters.push_back(PNG_PF_Sub);
+   filters.push_back(PNG_PF_Paeth);
+   for (int bit_depth = 1; bit_depth <= 4; bit_depth *= 2)
+   {
+      check_unfilter(13, 9, bit_depth, 0, filters);
+      check_unfilter(29, 9, bit_depth, 3, filters);
+   }
+}
+
+TEST(png,write_read_rgb)
+{
+   static const int widths[] = { 1, 17, 101 };
+   for (int width : widths)
+   {
+      bitmap_rgb32 bitmap;
+      build_noisy_bitmap(bitmap, width, 21, false);
+      bitmap_argb32 result;
+      write_and_read(bitmap, result);
+
+      ASSERT_EQ(width, result.width());
+      ASSERT_EQ(21, result.height());
+      for (int y = 0; y < 21; y++)
+         for (int x = 0; x < width; x++)
+            EXPECT_EQ(bitmap.pix32(y, x) | 0xff000000, result.pix32(y, x)) << "width " << width << " at " << x << "," << y;
+   }
+}
+
+TEST(png,write_read_rgba)
+{
+   static const int widths[] = { 1, 17, 101 };
+   for (int width : widths)
+   {
+      bitmap_argb32 bitmap;
+      build_noisy_bitmap(bitmap, width, 21, true);
+      bitmap_argb32 result;
+      write_and_read(bitmap, result);
+
+      ASSERT_EQ(width, result.width());
+      ASSERT_EQ(21, result.height());
+      for (int y = 0; y < 21; y++)
+         for (int x = 0; x < width; x++)
+            EXPECT_EQ(bitmap.pix32(y, x), result.pix32(y, x)) << "width " << width << " at " << x << "," << y;
+   }
+}